@@ -0,0 +1,91 @@
+#include "arena.h"
+
+Arena *Arena_create(size_t blockSize)
+{
+    Arena *arena = (Arena *)calloc(1, sizeof(Arena));
+    AssertNew(arena);
+
+    arena->blocks = NULL;
+    arena->blockSize = blockSize > 0 ? blockSize : ARENA_BLOCK_SIZE;
+
+    return arena;
+}
+
+void Arena_destroy(Arena *arena)
+{
+    if (!arena) return;
+
+    ArenaBlock *block = arena->blocks;
+    while (block)
+    {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
+void *Arena_alloc(Arena *arena, size_t size)
+{
+    // On arrondit la taille pour que la zone suivante reste alignée.
+    size_t align = sizeof(max_align_t);
+    size = (size + align - 1) / align * align;
+
+    ArenaBlock *block = arena->blocks;
+    if (!block || block->capacity - block->used < size)
+    {
+        // Les grandes allocations ont leur propre bloc, placé derrière le
+        // bloc courant pour ne pas perdre la place restante de celui-ci.
+        size_t capacity = size > arena->blockSize ? size : arena->blockSize;
+        ArenaBlock *newBlock = (ArenaBlock *)malloc(sizeof(ArenaBlock) + capacity);
+        AssertNew(newBlock);
+        newBlock->capacity = capacity;
+        newBlock->used = 0;
+
+        if (block && capacity > arena->blockSize)
+        {
+            newBlock->next = block->next;
+            block->next = newBlock;
+        }
+        else
+        {
+            newBlock->next = block;
+            arena->blocks = newBlock;
+        }
+        block = newBlock;
+    }
+
+    void *ptr = (char *)block->data + block->used;
+    block->used += size;
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+char *Arena_strndup(Arena *arena, const char *string, size_t length)
+{
+    char *copy = (char *)Arena_alloc(arena, length + 1);
+    memcpy(copy, string, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+void Arena_merge(Arena *dest, Arena *src)
+{
+    if (!src->blocks) return;
+
+    // Les blocs de src sont placés derrière le bloc courant de dest.
+    ArenaBlock *last = src->blocks;
+    while (last->next)
+        last = last->next;
+
+    if (dest->blocks)
+    {
+        last->next = dest->blocks->next;
+        dest->blocks->next = src->blocks;
+    }
+    else
+    {
+        dest->blocks = src->blocks;
+    }
+    src->blocks = NULL;
+}
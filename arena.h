@@ -0,0 +1,76 @@
+#pragma once
+
+#include "settings.h"
+
+#include <stddef.h>
+
+/// @brief Taille par défaut des blocs d'une arène.
+#define ARENA_BLOCK_SIZE (1 << 16)
+
+typedef struct sArenaBlock ArenaBlock;
+
+/// @brief Structure représentant un bloc mémoire d'une arène.
+struct sArenaBlock
+{
+    /// @brief Bloc suivant dans la liste des blocs de l'arène.
+    ArenaBlock *next;
+
+    /// @brief Taille de la zone data en octets.
+    size_t capacity;
+
+    /// @brief Nombre d'octets déjà utilisés dans la zone data.
+    size_t used;
+
+    /// @brief Zone mémoire du bloc.
+    max_align_t data[];
+};
+
+typedef struct sArena Arena;
+
+/// @brief Structure représentant une arène (allocateur par incrémentation).
+/// Les allocations sont faites les unes à la suite des autres dans de grands
+/// blocs et ne peuvent pas être libérées individuellement : toute la mémoire
+/// est libérée en une fois par Arena_destroy().
+/// Une arène ne doit pas être utilisée par plusieurs threads en même temps.
+struct sArena
+{
+    /// @brief Liste des blocs, le bloc courant en tête.
+    ArenaBlock *blocks;
+
+    /// @brief Taille minimale des nouveaux blocs.
+    size_t blockSize;
+};
+
+/// @brief Crée une arène vide.
+/// @param blockSize la taille minimale des blocs alloués par l'arène
+/// (ARENA_BLOCK_SIZE si 0).
+/// @return L'arène créée.
+Arena *Arena_create(size_t blockSize);
+
+/// @brief Détruit une arène ainsi que toute la mémoire qu'elle a allouée.
+/// @param arena l'arène.
+void Arena_destroy(Arena *arena);
+
+/// @brief Alloue une zone mémoire initialisée à zéro dans une arène.
+/// La zone est alignée pour tout type de données et reste valide jusqu'à la
+/// destruction de l'arène.
+/// Cette méthode s'exécute en temps constant (hors initialisation).
+/// @param arena l'arène.
+/// @param size la taille de la zone en octets.
+/// @return Le début de la zone.
+void *Arena_alloc(Arena *arena, size_t size);
+
+/// @brief Copie une chaîne de caractères dans une arène.
+/// @param arena l'arène.
+/// @param string la chaîne.
+/// @param length la taille de la chaîne en octets (sans le '\0').
+/// @return La copie terminée par '\0'.
+char *Arena_strndup(Arena *arena, const char *string, size_t length);
+
+/// @brief Transfère toute la mémoire d'une arène dans une autre.
+/// Les zones allouées dans src restent valides et seront libérées avec dest ;
+/// src est vidée et peut être réutilisée.
+/// Cette méthode s'exécute en temps proportionnel au nombre de blocs de src.
+/// @param dest l'arène de destination.
+/// @param src l'arène source.
+void Arena_merge(Arena *dest, Arena *src);
@@ -0,0 +1,485 @@
+#include "settings.h"
+#include "dict.h"
+#include "frozenDict.h"
+#include "uniStr.h"
+#include "csv.h"
+#include "uniStrView.h"
+#include "graph.h"
+#include "nodeOrder.h"
+
+// Micro-benchmarks des structures de données.
+// Usage : TPBench [nom du benchmark]
+// Sans argument, tous les benchmarks sont exécutés.
+
+/// @brief Renvoie le temps processeur écoulé en secondes.
+INLINE double benchTime() {
+    return (double) clock() / CLOCKS_PER_SEC;
+}
+
+/// @brief Générateur pseudo-aléatoire déterministe (xorshift).
+INLINE uint32_t benchRand(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+/// @brief Mesure les insertions et recherches dans un dictionnaire avec des
+/// clés au format des numéros INSEE.
+void benchDict() {
+    const int keyCount = 35000;
+    const int lookupCount = 5000000;
+    uint32_t state = 2463534242u;
+
+    char (*keys)[8] = calloc(keyCount, sizeof(*keys));
+    AssertNew(keys);
+    for (int i = 0; i < keyCount; i++) {
+        int department = 1 + i / 400;
+        sprintf(keys[i], "%02d%03d", department % 100, (i % 400) * 2 + 1);
+    }
+
+    Dict *dict = Dict_create();
+    double start = benchTime();
+    for (int i = 0; i < keyCount; i++)
+        Dict_insert(dict, keys[i], keys[i]);
+    double insertTime = benchTime() - start;
+
+    // Construction en bloc à partir des mêmes couples (déjà triés).
+    KVPair *pairs = calloc(keyCount, sizeof(KVPair));
+    AssertNew(pairs);
+    for (int i = 0; i < keyCount; i++) {
+        pairs[i].key = keys[i];
+        pairs[i].value = keys[i];
+    }
+    start = benchTime();
+    Dict *bulkDict = Dict_createFromArray(pairs, keyCount);
+    double bulkTime = benchTime() - start;
+    Dict_destroy(bulkDict);
+    free(pairs);
+
+    // Recherches dans un ordre aléatoire, dont un quart de clés absentes.
+    char missing[8];
+    long found = 0;
+    start = benchTime();
+    for (int i = 0; i < lookupCount; i++) {
+        uint32_t r = benchRand(&state);
+        char *key = keys[r % keyCount];
+        if ((r >> 30) == 0) {
+            memcpy(missing, key, sizeof(missing));
+            missing[4] = 'X';
+            key = missing;
+        }
+        if (Dict_get(dict, key))
+            found++;
+    }
+    double lookupTime = benchTime() - start;
+
+    // Mêmes recherches dans le dictionnaire figé.
+    FrozenDict *frozen = Dict_freeze(dict);
+    long frozenFound = 0;
+    state = 2463534242u;
+    start = benchTime();
+    for (int i = 0; i < lookupCount; i++) {
+        uint32_t r = benchRand(&state);
+        char *key = keys[r % keyCount];
+        if ((r >> 30) == 0) {
+            memcpy(missing, key, sizeof(missing));
+            missing[4] = 'X';
+            key = missing;
+        }
+        if (FrozenDict_get(frozen, key))
+            frozenFound++;
+    }
+    double frozenTime = benchTime() - start;
+    FrozenDict_destroy(frozen);
+
+#ifdef _DICT_HASH
+    const char *backend = "hash";
+#else
+    const char *backend = "avl";
+#endif
+    printf("dict (%s): insert %.1f ns/op, bulk %.1f ns/op, get %.1f ns/op (%ld found)\n", backend,
+           1e9 * insertTime / keyCount, 1e9 * bulkTime / keyCount,
+           1e9 * lookupTime / lookupCount, found);
+    printf("dict (%s): frozen get %.1f ns/op (%ld found)\n", backend,
+           1e9 * frozenTime / lookupCount, frozenFound);
+
+    Dict_destroy(dict);
+    free(keys);
+}
+
+/// @brief Mesure le décodage UTF8 d'une ligne répétée.
+/// @return Le débit en Mo/s.
+double benchUtf8Line(const char *line, int repeatCount) {
+    int size = (int) strlen(line) + 1;
+    long decoded = 0;
+    double start = benchTime();
+    for (int i = 0; i < repeatCount; i++) {
+        UniStr *string = UniStr_decodeU8((char *) line, size);
+        decoded += string->length;
+        UniStr_destroy(string);
+    }
+    double time = benchTime() - start;
+    if (decoded < 0)
+        printf("%ld\n", decoded);
+    return 1e-6 * size * repeatCount / time;
+}
+
+/// @brief Mesure le décodage UTF8 de lignes ASCII, de lignes accentuées et
+/// d'un grand buffer ASCII.
+void benchUtf8() {
+    const char *asciiLine = "01001,L ABERGEMENT CLEMENCIAT,01400,L ABERGEMENT CLEMENCIAT,,"
+                            "46.153721024,4.92850176311";
+    const char *accentLine = "26281,SAINT-ÉTIENNE-DE-SAINT-GEOIRS,38590,Île-de-France,Sœur Thérèse,"
+                             "45.3402,5.3457";
+    const int repeatCount = 500000;
+
+    const int bufferSize = 1 << 22;
+    char *buffer = calloc(bufferSize, sizeof(char));
+    AssertNew(buffer);
+    for (int i = 0; i < bufferSize - 1; i++)
+        buffer[i] = asciiLine[i % (int) strlen(asciiLine)];
+    double start = benchTime();
+    const int bufferRepeatCount = 20;
+    for (int i = 0; i < bufferRepeatCount; i++)
+        UniStr_destroy(UniStr_decodeU8(buffer, bufferSize));
+    double bufferTime = benchTime() - start;
+    free(buffer);
+
+#ifdef _UNISTR_SCALAR
+    const char *backend = "scalar";
+#else
+    const char *backend = "simd";
+#endif
+    printf("utf8 (%s): ascii line %.0f MB/s, accented line %.0f MB/s, 4 MB buffer %.0f MB/s\n", backend,
+           benchUtf8Line(asciiLine, repeatCount), benchUtf8Line(accentLine, repeatCount),
+           1e-6 * bufferSize * bufferRepeatCount / bufferTime);
+}
+
+/// @brief Mesure le découpage de lignes csv de 20 colonnes (format des POI).
+void benchCsv() {
+    const char *row = "node\t4.8357\t45.764\tamenity\tLe Café des Arts\tbar\t\t\t69001\tLyon\t"
+                      "Rue de la République\t12\tyes\t\tMo-Su 17:00-02:00\t\t\t\tFR\t1\n";
+    const int rowCount = 200000;
+    int rowLength = (int) strlen(row);
+    size_t size = (size_t) rowLength * rowCount;
+    char *buffer = calloc(size, sizeof(char));
+    AssertNew(buffer);
+    for (int i = 0; i < rowCount; i++)
+        memcpy(buffer + (size_t) i * rowLength, row, rowLength);
+
+    CsvReader reader = {0};
+    reader.data = buffer;
+    reader.size = size;
+    reader.separator = '\t';
+    CsvField fields[20];
+    long fieldCount = 0;
+
+    const int repeatCount = 10;
+    double start = benchTime();
+    for (int i = 0; i < repeatCount; i++) {
+        reader.curr = buffer;
+        reader.end = buffer + size;
+        int count;
+        while ((count = CsvReader_nextRow(&reader, fields, 20)) >= 0)
+            fieldCount += count;
+    }
+    double time = benchTime() - start;
+
+    printf("csv: nextRow %.1f ns/row, %.0f MB/s (%ld fields)\n",
+           1e9 * time / ((double) rowCount * repeatCount), 1e-6 * size * repeatCount / time, fieldCount);
+    free(buffer);
+}
+
+/// @brief Mesure la translittération en ASCII et la normalisation des noms de
+/// communes.
+void benchAscii() {
+    const char *names[] = {
+        "Châlons-en-Champagne", "L'Haÿ-les-Roses", "Saint-Étienne", "Œuilly",
+        "Lyon", "Bourg-en-Bresse", "Aÿ-Champagne", "Plœmeur", "Nîmes", "Besançon",
+        "PARIS 01", "Aix-en-Provence", "Fontenay-sous-Bois", "Évry-Courcouronnes"
+    };
+    const int nameCount = (int) (sizeof(names) / sizeof(names[0]));
+    const int repeatCount = 200000;
+    UniStr *decoded[sizeof(names) / sizeof(names[0])];
+    for (int i = 0; i < nameCount; i++)
+        decoded[i] = UniStr_decodeU8((char *) names[i], -1);
+
+    char buffer[128];
+    long checksum = 0;
+    double start = benchTime();
+    for (int r = 0; r < repeatCount; r++) {
+        for (int i = 0; i < nameCount; i++) {
+            char *ascii = UniStr_encodeAscii(decoded[i]);
+            checksum += ascii[0];
+            free(ascii);
+        }
+    }
+    double encodeTime = benchTime() - start;
+
+    start = benchTime();
+    for (int r = 0; r < repeatCount; r++) {
+        for (int i = 0; i < nameCount; i++)
+            checksum += UniStr_encodeAsciiTo(decoded[i], buffer, sizeof(buffer));
+    }
+    double encodeToTime = benchTime() - start;
+
+    start = benchTime();
+    for (int r = 0; r < repeatCount; r++) {
+        for (int i = 0; i < nameCount; i++) {
+            UniStr *string = UniStr_decodeU8((char *) names[i], -1);
+            char *ascii = UniStr_encodeAscii(string);
+            for (char *curr = ascii; *curr; curr++)
+                *curr = *curr == '-' ? ' ' : (char) toupper((unsigned char) *curr);
+            checksum += ascii[0];
+            free(ascii);
+            UniStr_destroy(string);
+        }
+    }
+    double chainTime = benchTime() - start;
+
+    start = benchTime();
+    for (int r = 0; r < repeatCount; r++) {
+        for (int i = 0; i < nameCount; i++)
+            checksum += UniStr_normalizeU8(names[i], buffer, sizeof(buffer));
+    }
+    double normalizeTime = benchTime() - start;
+
+    double count = (double) repeatCount * nameCount;
+    printf("ascii: encodeAscii %.1f ns, encodeAsciiTo %.1f ns, "
+           "decode + encodeAscii + toupper %.1f ns, normalizeU8 %.1f ns (%ld)\n",
+           1e9 * encodeTime / count, 1e9 * encodeToTime / count,
+           1e9 * chainTime / count, 1e9 * normalizeTime / count, checksum);
+    for (int i = 0; i < nameCount; i++)
+        UniStr_destroy(decoded[i]);
+}
+
+/// @brief Mesure une recherche de sous-chaîne dans une longue chaîne, avec
+/// UniStr et avec UniStrView.
+void benchFindCase(const char *label, const char *text, const char *sub, int repeatCount) {
+    UniStr *string = UniStr_decodeU8((char *) text, -1);
+    UniStr *uniSub = UniStr_decodeU8((char *) sub, -1);
+    UniStrView view = UniStrView_make(text, -1);
+    UniStrView viewSub = UniStrView_make(sub, -1);
+    long checksum = 0;
+
+    double start = benchTime();
+    for (int i = 0; i < repeatCount; i++)
+        checksum += UniStr_find(string, uniSub) + UniStr_count(string, uniSub);
+    double uniTime = benchTime() - start;
+
+    start = benchTime();
+    for (int i = 0; i < repeatCount; i++)
+        checksum += UniStrView_find(view, viewSub) + UniStrView_count(view, viewSub);
+    double viewTime = benchTime() - start;
+
+    double size = 1e-6 * view.length * repeatCount;
+    printf("find: %s: UniStr find + count %.0f MB/s, UniStrView find + count %.0f MB/s (%ld)\n",
+           label, 2 * size / uniTime, 2 * size / viewTime, checksum);
+    UniStr_destroy(string);
+    UniStr_destroy(uniSub);
+}
+
+/// @brief Mesure la recherche de sous-chaînes dans de longues chaînes.
+void benchFind() {
+    const int size = 1 << 20;
+    char *text = calloc(size + 1, sizeof(char));
+    AssertNew(text);
+
+    // Noms de points d'intérêt : la sous-chaîne n'apparaît qu'à la fin.
+    const char *names[] = {
+        "Le Café des Arts", "Boulangerie Paul", "Pharmacie du Centre", "Musée des Beaux-Arts",
+        "Gare de Lyon Part-Dieu", "Parc de la Tête d'Or", "Bibliothèque municipale"
+    };
+    int length = 0;
+    for (int i = 0; length + 64 < size; i++) {
+        const char *name = names[i % 7];
+        length += sprintf(text + length, "%s; ", name);
+    }
+    strcpy(text + length, "Boulangerie du Port");
+    benchFindCase("poi names", text, "Boulangerie du Port", 20);
+
+    // Sous-chaîne périodique : pire cas de la recherche naïve.
+    memset(text, 'a', size);
+    text[size] = '\0';
+    char sub[65];
+    memset(sub, 'a', 63);
+    sub[63] = 'b';
+    sub[64] = '\0';
+    benchFindCase("a^n / a^63 b", text, sub, 20);
+
+    // Premier et dernier caractères présents partout : seul l'algorithme
+    // Two-Way garantit un temps linéaire.
+    sub[63] = 'a';
+    sub[31] = 'b';
+    benchFindCase("a^n / a^31 b a^32", text, sub, 20);
+
+    free(text);
+}
+
+/// @brief Noeud du graphe de benchmark associé à sa clé de tri.
+typedef struct sBenchNode {
+    uint32_t key;
+    int index;
+} BenchNode;
+
+/// @brief Compare deux noeuds du graphe de benchmark par clé.
+int benchNodeCompare(const void *a, const void *b) {
+    const BenchNode *nodeA = a, *nodeB = b;
+    return (nodeA->key > nodeB->key) - (nodeA->key < nodeB->key);
+}
+
+/// @brief Mesure le nombre d'arcs relâchés par seconde par l'algorithme de
+/// Dijkstra sur un graphe de communes fictif.
+/// @return Le nombre d'arcs relâchés par seconde.
+double benchDijkstra(Graph *graph, const int *sources, int sourceCount) {
+    int size = Graph_size(graph);
+    int *predecessors = calloc(size, sizeof(int));
+    float *distances = calloc(size, sizeof(float));
+    AssertNew(predecessors);
+    AssertNew(distances);
+
+    long arcCount = 0;
+    double time = 0;
+    for (int i = 0; i < sourceCount; i++) {
+        double start = benchTime();
+        Graph_dijkstra(graph, sources[i], -1, predecessors, distances);
+        time += benchTime() - start;
+        for (int u = 0; u < size; u++) {
+            if (distances[u] < INFINITY)
+                arcCount += Graph_getPositiveValency(graph, u);
+        }
+    }
+    free(predecessors);
+    free(distances);
+    return arcCount / time;
+}
+
+/// @brief Mesure l'effet de la renumérotation des noeuds le long d'une courbe
+/// de Hilbert sur l'algorithme de Dijkstra.
+/// Les noeuds sont des points aléatoires reliés à leurs voisins proches (six
+/// en moyenne). Comme dans le fichier des communes, ils sont d'abord numérotés
+/// par « département » (carré d'une grille 10 x 10) puis dans un ordre
+/// quelconque au sein de chaque département.
+void benchGraphCase(int nodeCount) {
+    uint32_t state = 2463534242u;
+    double *latitudes = calloc(nodeCount, sizeof(double));
+    double *longitudes = calloc(nodeCount, sizeof(double));
+    BenchNode *nodes = calloc(nodeCount, sizeof(BenchNode));
+    AssertNew(latitudes);
+    AssertNew(longitudes);
+    AssertNew(nodes);
+
+    // Numérotation par département.
+    for (int i = 0; i < nodeCount; i++) {
+        double latitude = benchRand(&state) / 4294967296.0;
+        double longitude = benchRand(&state) / 4294967296.0;
+        nodes[i].key = (uint32_t) ((int) (latitude * 10) * 10 + (int) (longitude * 10)) << 24 |
+                       (benchRand(&state) >> 8);
+        nodes[i].index = i;
+        latitudes[i] = latitude;
+        longitudes[i] = longitude;
+    }
+    qsort(nodes, nodeCount, sizeof(BenchNode), benchNodeCompare);
+    double *sortedLatitudes = calloc(nodeCount, sizeof(double));
+    double *sortedLongitudes = calloc(nodeCount, sizeof(double));
+    AssertNew(sortedLatitudes);
+    AssertNew(sortedLongitudes);
+    for (int i = 0; i < nodeCount; i++) {
+        sortedLatitudes[i] = latitudes[nodes[i].index];
+        sortedLongitudes[i] = longitudes[nodes[i].index];
+    }
+
+    // Répartition des noeuds dans une grille de cases de côté radius.
+    double radius = sqrt(6.0 / (M_PI * nodeCount));
+    int gridSize = (int) (1.0 / radius) + 1;
+    int *cellStarts = calloc(gridSize * gridSize + 1, sizeof(int));
+    int *cellNodes = calloc(nodeCount, sizeof(int));
+    int *cellFill = calloc(gridSize * gridSize, sizeof(int));
+    AssertNew(cellStarts);
+    AssertNew(cellNodes);
+    AssertNew(cellFill);
+    for (int i = 0; i < nodeCount; i++)
+        cellStarts[(int) (sortedLatitudes[i] / radius) * gridSize + (int) (sortedLongitudes[i] / radius) + 1]++;
+    for (int c = 0; c < gridSize * gridSize; c++)
+        cellStarts[c + 1] += cellStarts[c];
+    for (int i = 0; i < nodeCount; i++) {
+        int c = (int) (sortedLatitudes[i] / radius) * gridSize + (int) (sortedLongitudes[i] / radius);
+        cellNodes[cellStarts[c] + cellFill[c]++] = i;
+    }
+
+    // Arcs entre les noeuds distants de moins de radius.
+    Graph *fileGraph = Graph_create(nodeCount);
+    for (int u = 0; u < nodeCount; u++) {
+        int x = (int) (sortedLatitudes[u] / radius);
+        int y = (int) (sortedLongitudes[u] / radius);
+        for (int a = x - 1; a <= x + 1; a++) {
+            for (int b = y - 1; b <= y + 1; b++) {
+                if (a < 0 || a >= gridSize || b < 0 || b >= gridSize)
+                    continue;
+                int c = a * gridSize + b;
+                for (int k = cellStarts[c]; k < cellStarts[c + 1]; k++) {
+                    int v = cellNodes[k];
+                    double distance = hypot(sortedLatitudes[u] - sortedLatitudes[v],
+                                            sortedLongitudes[u] - sortedLongitudes[v]);
+                    if (v != u && distance < radius)
+                        Graph_set(fileGraph, u, v, (float) distance);
+                }
+            }
+        }
+    }
+
+    NodeOrder *order = NodeOrder_createHilbert(sortedLatitudes, sortedLongitudes, nodeCount);
+    Graph *hilbertGraph = NodeOrder_applyToGraph(order, fileGraph);
+
+    // Mêmes sources dans les deux numérotations.
+    int fileSources[8], hilbertSources[8];
+    for (int i = 0; i < 8; i++) {
+        fileSources[i] = (int) (benchRand(&state) % nodeCount);
+        hilbertSources[i] = order->newIds[fileSources[i]];
+    }
+    double fileRate = benchDijkstra(fileGraph, fileSources, 8);
+    double hilbertRate = benchDijkstra(hilbertGraph, hilbertSources, 8);
+
+    printf("graph: %d nodes: dijkstra file order %.1f M arcs/s, hilbert order %.1f M arcs/s (x%.2f)\n",
+           nodeCount, 1e-6 * fileRate, 1e-6 * hilbertRate, hilbertRate / fileRate);
+
+    Graph_destroy(fileGraph);
+    Graph_destroy(hilbertGraph);
+    NodeOrder_destroy(order);
+    free(cellStarts);
+    free(cellNodes);
+    free(cellFill);
+    free(sortedLatitudes);
+    free(sortedLongitudes);
+    free(nodes);
+    free(latitudes);
+    free(longitudes);
+}
+
+/// @brief Mesure la renumérotation des noeuds pour un graphe de la taille de
+/// celui des communes et pour un graphe dix fois plus grand.
+void benchGraph() {
+    benchGraphCase(35000);
+    benchGraphCase(350000);
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = argc > 1 ? argv[1] : NULL;
+
+    if (!name || !strcmp(name, "dict"))
+        benchDict();
+    if (!name || !strcmp(name, "utf8"))
+        benchUtf8();
+    if (!name || !strcmp(name, "csv"))
+        benchCsv();
+    if (!name || !strcmp(name, "ascii"))
+        benchAscii();
+    if (!name || !strcmp(name, "find"))
+        benchFind();
+    if (!name || !strcmp(name, "graph"))
+        benchGraph();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,321 @@
+#include "csv.h"
+#include "mappedFile.h"
+#include "number.h"
+
+// Les séparateurs et retours à la ligne sont repérés 64 octets à la fois avec
+// les instructions SSE2 (toujours présentes en x86-64) : le masque obtenu
+// donne directement la fin des champs suivants de la ligne.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CSV_SIMD
+#include <immintrin.h>
+#endif
+
+/// @brief Structure mémorisant les positions des fins de champs possibles
+/// (séparateurs et retours à la ligne) d'une zone de 64 octets.
+typedef struct sCsvScanner
+{
+    /// @brief Début de la zone.
+    const char *base;
+
+    /// @brief Le bit i vaut 1 si base[i] est un séparateur ou un '\n'.
+    uint64_t mask;
+
+    /// @brief false tant qu'aucune zone n'a été analysée.
+    bool valid;
+} CsvScanner;
+
+#ifdef CSV_SIMD
+/// @brief Renvoie le masque des séparateurs et retours à la ligne de 64
+/// octets.
+INLINE uint64_t CsvScanner_getMask(const char *data, char separator)
+{
+    const __m128i separators = _mm_set1_epi8(separator);
+    const __m128i newLines = _mm_set1_epi8('\n');
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + 16 * i));
+        uint64_t blockMask = (uint16_t)_mm_movemask_epi8(_mm_or_si128(
+            _mm_cmpeq_epi8(block, separators), _mm_cmpeq_epi8(block, newLines)));
+        mask |= blockMask << (16 * i);
+    }
+    return mask;
+}
+#endif
+
+/// @brief Renvoie la position du premier séparateur ou retour à la ligne
+/// d'une zone, ou la fin de la zone s'il n'y en a pas.
+INLINE const char *CsvScanner_findFieldEnd(
+    CsvScanner *scanner, const char *curr, const char *end, char separator)
+{
+#ifdef CSV_SIMD
+    while (true)
+    {
+        if (!scanner->valid || curr < scanner->base || curr >= scanner->base + 64)
+        {
+            if (end - curr < 64)
+                break;
+            scanner->base = curr;
+            scanner->mask = CsvScanner_getMask(curr, separator);
+            scanner->valid = true;
+        }
+        uint64_t mask = scanner->mask >> (curr - scanner->base);
+        if (mask)
+            return curr + __builtin_ctzll(mask);
+        curr = scanner->base + 64;
+    }
+#else
+    (void)scanner;
+#endif
+    while (curr < end && *curr != separator && *curr != '\n')
+        curr++;
+    return curr;
+}
+
+CsvReader *CsvReader_open(const char *filename, char separator)
+{
+    void *data = NULL;
+    size_t size = 0;
+    if (!MappedFile_open(filename, &data, &size))
+        return NULL;
+
+    CsvReader *reader = (CsvReader *)calloc(1, sizeof(CsvReader));
+    AssertNew(reader);
+
+    reader->data = data;
+    reader->size = size;
+    reader->curr = data;
+    reader->end = (const char *)data + size;
+    reader->separator = separator;
+
+    return reader;
+}
+
+void CsvReader_close(CsvReader *reader)
+{
+    if (!reader) return;
+
+    MappedFile_close(reader->data, reader->size);
+    free(reader);
+}
+
+int CsvReader_nextRow(CsvReader *reader, CsvField *fields, int maxFields)
+{
+    const char *curr = reader->curr;
+    const char *end = reader->end;
+    char separator = reader->separator;
+
+    if (curr == NULL || curr >= end)
+        return -1;
+
+    CsvScanner scanner = { NULL, 0, false };
+    int count = 0;
+    while (true)
+    {
+        CsvField field = { curr, 0, false };
+
+        if (curr < end && *curr == '"')
+        {
+            // Champ entre guillemets : il se termine au premier guillemet
+            // qui n'est pas doublé.
+            curr++;
+            field.data = curr;
+            while (curr < end)
+            {
+                const char *quote = memchr(curr, '"', end - curr);
+                if (!quote)
+                {
+                    curr = end;
+                    break;
+                }
+                if (quote + 1 < end && quote[1] == '"')
+                {
+                    field.escaped = true;
+                    curr = quote + 2;
+                    continue;
+                }
+                curr = quote;
+                break;
+            }
+            field.length = (int)(curr - field.data);
+            if (curr < end)
+                curr++;
+
+            // Les caractères entre le guillemet fermant et le séparateur sont ignorés.
+            curr = CsvScanner_findFieldEnd(&scanner, curr, end, separator);
+        }
+        else
+        {
+            curr = CsvScanner_findFieldEnd(&scanner, curr, end, separator);
+            field.length = (int)(curr - field.data);
+
+            // Fin de ligne "\r\n".
+            if (field.length > 0 && field.data[field.length - 1] == '\r' &&
+                (curr >= end || *curr == '\n'))
+                field.length--;
+        }
+
+        if (count < maxFields)
+            fields[count] = field;
+        count++;
+
+        if (curr < end && *curr == separator)
+        {
+            curr++;
+            continue;
+        }
+        if (curr < end && *curr == '\n')
+            curr++;
+        break;
+    }
+
+    reader->curr = curr;
+    return count;
+}
+
+bool CsvReader_peekField(CsvReader *reader, int index, CsvField *field)
+{
+    const char *curr = reader->curr;
+    const char *end = reader->end;
+
+    if (curr == NULL || curr >= end)
+        return false;
+
+    const char *lineEnd = memchr(curr, '\n', end - curr);
+    if (!lineEnd)
+        lineEnd = end;
+
+    for (int i = 0; i < index; i++)
+    {
+        if (curr >= lineEnd || *curr == '"')
+            return false;
+        const char *separator = memchr(curr, reader->separator, (size_t)(lineEnd - curr));
+        if (!separator)
+            return false;
+        curr = separator + 1;
+    }
+    if (curr < lineEnd && *curr == '"')
+        return false;
+
+    const char *fieldEnd = NULL;
+    if (curr < lineEnd)
+        fieldEnd = memchr(curr, reader->separator, (size_t)(lineEnd - curr));
+    if (!fieldEnd)
+    {
+        fieldEnd = lineEnd;
+        // Fin de ligne "\r\n".
+        if (fieldEnd > curr && fieldEnd[-1] == '\r')
+            fieldEnd--;
+    }
+
+    field->data = curr;
+    field->length = (int)(fieldEnd - curr);
+    field->escaped = false;
+    return true;
+}
+
+void CsvReader_skipRow(CsvReader *reader)
+{
+    const char *curr = reader->curr;
+    const char *end = reader->end;
+
+    if (curr == NULL || curr >= end)
+        return;
+
+    const char *lineEnd = memchr(curr, '\n', end - curr);
+    if (!lineEnd)
+        lineEnd = end;
+
+    // Un champ entre guillemets peut contenir un retour à la ligne.
+    if (memchr(curr, '"', lineEnd - curr))
+    {
+        CsvReader_nextRow(reader, NULL, 0);
+        return;
+    }
+    reader->curr = lineEnd < end ? lineEnd + 1 : end;
+}
+
+void CsvReader_split(CsvReader *reader, CsvReader *chunks, int chunkCount)
+{
+    const char *begin = reader->curr ? reader->curr : reader->end;
+    const char *end = reader->end;
+    size_t size = (size_t)(end - begin);
+
+    const char *curr = begin;
+    for (int i = 0; i < chunkCount; i++)
+    {
+        // On avance jusqu'au début de la ligne suivant la position théorique
+        // de la fin du morceau.
+        const char *next = end;
+        if (i < chunkCount - 1)
+        {
+            next = begin + size / chunkCount * (i + 1);
+            if (next < curr)
+                next = curr;
+            if (next > begin && next < end && next[-1] != '\n')
+            {
+                const char *newLine = memchr(next, '\n', end - next);
+                next = newLine ? newLine + 1 : end;
+            }
+        }
+
+        chunks[i] = *reader;
+        chunks[i].curr = curr;
+        chunks[i].end = next;
+        curr = next;
+    }
+}
+
+bool CsvField_equals(const CsvField *field, const char *string)
+{
+    int length = (int)strlen(string);
+    return !field->escaped && field->length == length &&
+        memcmp(field->data, string, length) == 0;
+}
+
+int CsvField_copyTo(const CsvField *field, char *buffer, int bufferSize)
+{
+    if (bufferSize <= 0)
+        return 0;
+
+    int idx = 0;
+    for (int i = 0; i < field->length && idx < bufferSize - 1; i++)
+    {
+        buffer[idx++] = field->data[i];
+        // Un guillemet doublé n'est copié qu'une fois.
+        if (field->escaped && field->data[i] == '"' && i + 1 < field->length)
+            i++;
+    }
+    buffer[idx] = '\0';
+    return idx;
+}
+
+char *CsvField_copy(const CsvField *field)
+{
+    char *string = (char *)calloc(field->length + 1, sizeof(char));
+    AssertNew(string);
+    CsvField_copyTo(field, string, field->length + 1);
+    return string;
+}
+
+double CsvField_getDouble(const CsvField *field)
+{
+    if (field->escaped)
+    {
+        char buffer[65];
+        int length = CsvField_copyTo(field, buffer, sizeof(buffer));
+        return Number_parseDouble(buffer, length, NULL);
+    }
+    return Number_parseDouble(field->data, field->length, NULL);
+}
+
+int64_t CsvField_getFixed(const CsvField *field, int decimals)
+{
+    if (field->escaped)
+    {
+        char buffer[65];
+        int length = CsvField_copyTo(field, buffer, sizeof(buffer));
+        return Number_parseFixed(buffer, length, decimals, NULL);
+    }
+    return Number_parseFixed(field->data, field->length, decimals, NULL);
+}
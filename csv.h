@@ -0,0 +1,132 @@
+#pragma once
+
+#include "settings.h"
+#include "uniStrView.h"
+
+/// @brief Structure représentant un champ d'une ligne csv.
+/// Le champ désigne directement le contenu du fichier projeté en mémoire :
+/// il n'est pas terminé par '\0' et reste valide tant que le lecteur est ouvert.
+typedef struct sCsvField
+{
+    /// @brief Début du champ (sans les guillemets éventuels).
+    const char *data;
+
+    /// @brief Taille du champ en octets.
+    int length;
+
+    /// @brief true si le champ est entre guillemets et contient des guillemets
+    /// doublés ("") qu'il faut remplacer par un seul guillemet.
+    bool escaped;
+} CsvField;
+
+/// @brief Structure représentant un lecteur de fichier csv projeté en mémoire.
+typedef struct sCsvReader
+{
+    /// @brief Début du fichier projeté en mémoire.
+    char *data;
+
+    /// @brief Taille du fichier en octets.
+    size_t size;
+
+    /// @brief Position de la prochaine ligne à lire.
+    const char *curr;
+
+    /// @brief Fin de la zone à lire.
+    const char *end;
+
+    /// @brief Séparateur des champs.
+    char separator;
+} CsvReader;
+
+/// @brief Ouvre un fichier csv en le projetant en mémoire.
+/// Les champs peuvent être entourés de guillemets, ils peuvent alors contenir
+/// le séparateur, des retours à la ligne et des guillemets doublés.
+/// @param filename chemin du fichier.
+/// @param separator le séparateur des champs.
+/// @return Le lecteur créé ou NULL si le fichier ne peut pas être ouvert.
+CsvReader *CsvReader_open(const char *filename, char separator);
+
+/// @brief Ferme un lecteur créé avec CsvReader_open().
+/// Les champs lus ne sont plus valides après l'appel.
+/// @param reader le lecteur.
+void CsvReader_close(CsvReader *reader);
+
+/// @brief Lit la ligne suivante d'un fichier csv.
+/// Les maxFields premiers champs sont écrits dans le tableau fields, les
+/// suivants sont ignorés. Les fins de ligne "\n" et "\r\n" sont acceptées.
+/// @param reader le lecteur.
+/// @param[out] fields tableau de maxFields champs.
+/// @param maxFields la taille du tableau fields.
+/// @return Le nombre de champs de la ligne (qui peut dépasser maxFields),
+/// -1 s'il n'y a plus de ligne à lire.
+int CsvReader_nextRow(CsvReader *reader, CsvField *fields, int maxFields);
+
+/// @brief Localise un champ de la ligne courante sans la lire entièrement ni
+/// avancer le lecteur.
+/// La recherche se limite aux séparateurs précédant le champ, ce qui permet
+/// d'écarter rapidement une ligne sur la valeur d'une seule colonne.
+/// @param reader le lecteur.
+/// @param index l'indice du champ dans la ligne.
+/// @param[out] field le champ trouvé.
+/// @return true si le champ a été trouvé, false si la ligne compte moins de
+/// index + 1 champs, si l'un des champs précédents ou le champ lui-même est
+/// entre guillemets, ou s'il n'y a plus de ligne à lire. Il faut alors lire
+/// la ligne avec CsvReader_nextRow().
+bool CsvReader_peekField(CsvReader *reader, int index, CsvField *field);
+
+/// @brief Passe la ligne courante sans découper ses champs.
+/// @param reader le lecteur.
+void CsvReader_skipRow(CsvReader *reader);
+
+/// @brief Découpe la zone restant à lire d'un lecteur en morceaux de tailles
+/// voisines commençant chacun au début d'une ligne.
+/// Les morceaux partagent le fichier projeté du lecteur : ils ne doivent pas
+/// être fermés et ne sont plus valides après la fermeture du lecteur.
+/// Les coupures se font sur les '\n', le fichier ne doit donc pas contenir de
+/// retour à la ligne entre guillemets.
+/// @param reader le lecteur.
+/// @param[out] chunks tableau de chunkCount lecteurs (certains peuvent être vides).
+/// @param chunkCount le nombre de morceaux.
+void CsvReader_split(CsvReader *reader, CsvReader *chunks, int chunkCount);
+
+/// @brief Compare un champ à une chaîne de caractères.
+/// @param field le champ.
+/// @param string la chaîne terminée par '\0'.
+/// @return true si le champ est égal à la chaîne, false sinon.
+bool CsvField_equals(const CsvField *field, const char *string);
+
+/// @brief Renvoie une vue sur le contenu d'un champ.
+/// Les guillemets doublés d'un champ échappé ne sont pas remplacés : il faut
+/// utiliser CsvField_copyTo() si field->escaped vaut true.
+/// @param field le champ.
+/// @return La vue.
+INLINE UniStrView CsvField_getView(const CsvField *field)
+{
+    return UniStrView_make(field->data, field->length);
+}
+
+/// @brief Copie un champ dans un buffer en remplaçant les guillemets doublés.
+/// Le contenu est tronqué si le buffer est trop petit.
+/// @param field le champ.
+/// @param buffer le buffer de destination.
+/// @param bufferSize la taille du buffer (terminateur '\0' compris).
+/// @return Le nombre d'octets écrits, sans le terminateur.
+int CsvField_copyTo(const CsvField *field, char *buffer, int bufferSize);
+
+/// @brief Copie un champ dans une chaîne allouée.
+/// @param field le champ.
+/// @return La chaîne terminée par '\0', à libérer avec free().
+char *CsvField_copy(const CsvField *field);
+
+/// @brief Renvoie la valeur décimale d'un champ (voir Number_parseDouble()).
+/// Le champ est lu directement dans le fichier, sans allocation.
+/// @param field le champ.
+/// @return La valeur lue ou 0.0 si le champ n'est pas un nombre.
+double CsvField_getDouble(const CsvField *field);
+
+/// @brief Renvoie la valeur en virgule fixe d'un champ (voir
+/// Number_parseFixed()).
+/// @param field le champ.
+/// @param decimals le nombre de décimales.
+/// @return La valeur lue multipliée par 10^decimals.
+int64_t CsvField_getFixed(const CsvField *field, int decimals);
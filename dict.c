@@ -1,5 +1,7 @@
 #include "dict.h"
 
+#ifndef _DICT_HASH
+
 bool Dict_find(Dict *dict, char *key, DictNode **res);
 void Dict_balance(Dict *dict, DictNode *node);
 
@@ -88,6 +90,86 @@ Dict *Dict_create()
     return dict;
 }
 
+/// @brief Trie un tableau de couples par clé en conservant l'ordre des
+/// couples de même clé (tri fusion).
+void Dict_sortPairs(KVPair *pairs, KVPair *buffer, int count)
+{
+    for (int width = 1; width < count; width *= 2)
+    {
+        for (int lo = 0; lo < count; lo += 2 * width)
+        {
+            int mid = lo + width < count ? lo + width : count;
+            int hi = lo + 2 * width < count ? lo + 2 * width : count;
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi)
+            {
+                if (strcmp(pairs[j].key, pairs[i].key) < 0)
+                    buffer[k++] = pairs[j++];
+                else
+                    buffer[k++] = pairs[i++];
+            }
+            while (i < mid) buffer[k++] = pairs[i++];
+            while (j < hi) buffer[k++] = pairs[j++];
+        }
+        Memcpy(pairs, count * sizeof(KVPair), buffer, count * sizeof(KVPair));
+    }
+}
+
+/// @brief Construit un AVL parfaitement équilibré à partir de couples triés
+/// par clé et sans doublon.
+DictNode *DictNode_createFromArray(const KVPair *pairs, int lo, int hi)
+{
+    if (lo > hi) return NULL;
+
+    int mid = lo + (hi - lo) / 2;
+    DictNode *node = DictNode_create(pairs[mid].key, pairs[mid].value);
+    DictNode_setLeft(node, DictNode_createFromArray(pairs, lo, mid - 1));
+    DictNode_setRight(node, DictNode_createFromArray(pairs, mid + 1, hi));
+    DictNode_update(node);
+
+    return node;
+}
+
+Dict *Dict_createFromArray(const KVPair *pairs, int count)
+{
+    Dict *dict = Dict_create();
+    if (count <= 0)
+        return dict;
+
+    KVPair *sorted = (KVPair *)calloc(count, sizeof(KVPair));
+    AssertNew(sorted);
+    Memcpy(sorted, count * sizeof(KVPair), pairs, count * sizeof(KVPair));
+
+    // Le tri n'est effectué que si les clés ne sont pas déjà dans l'ordre.
+    bool isSorted = true;
+    for (int i = 1; i < count && isSorted; i++)
+    {
+        isSorted = strcmp(sorted[i - 1].key, sorted[i].key) <= 0;
+    }
+    if (!isSorted)
+    {
+        KVPair *buffer = (KVPair *)calloc(count, sizeof(KVPair));
+        AssertNew(buffer);
+        Dict_sortPairs(sorted, buffer, count);
+        free(buffer);
+    }
+
+    // Pour chaque clé, on ne garde que le dernier couple.
+    int size = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (i + 1 < count && strcmp(sorted[i].key, sorted[i + 1].key) == 0)
+            continue;
+        sorted[size++] = sorted[i];
+    }
+
+    dict->root = DictNode_createFromArray(sorted, 0, size - 1);
+    dict->size = size;
+    free(sorted);
+
+    return dict;
+}
+
 void Dict_destroy(Dict *dict)
 {
     if (!dict) return;
@@ -426,3 +508,5 @@ bool DictIter_hasNext(DictIter *iter)
 {
     return iter->curr != NULL;
 }
+
+#endif
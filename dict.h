@@ -1,5 +1,8 @@
 #pragma once
 #include "settings.h"
+#include "arena.h"
+
+//#define _DICT_HASH
 
 /// @brief Structure représentant un couple clé/valeur dans un dictionnaire.
 typedef struct KVPair_s
@@ -11,6 +14,41 @@ typedef struct KVPair_s
     void *value;
 } KVPair;
 
+#ifdef _DICT_HASH
+
+/// @brief Structure représentant une case de la table de hachage d'un
+/// dictionnaire.
+typedef struct DictEntry_s
+{
+    /// @brief Valeur de hachage de la clé, 0 si la case est vide.
+    uint32_t hash;
+
+    /// @brief Couple clé/valeur associé à la case.
+    KVPair pair;
+} DictEntry;
+
+/// @brief Structure représentant un dictionnaire implémenté à partir d'une
+/// table de hachage à adressage ouvert (sondage linéaire).
+/// Les clés sont copiées dans une arène et ne sont libérées qu'avec le
+/// dictionnaire.
+typedef struct Dict_s
+{
+    /// @brief Table des cases.
+    DictEntry *entries;
+
+    /// @brief Nombre de cases de la table (puissance de 2).
+    int capacity;
+
+    /// @brief Taille du dictionnaire.
+    /// Egalement le nombre de cases occupées de la table.
+    int size;
+
+    /// @brief Arène contenant les clés.
+    Arena *keys;
+} Dict;
+
+#else
+
 /// @brief Structure représentant un noeud dans un dictionnaire implémenté
 /// à partir d'un AVL.
 typedef struct DictNode_s
@@ -42,10 +80,27 @@ typedef struct Dict_s
     int size;
 } Dict;
 
+#endif
+
 /// @brief Créé un nouveau dictionnaire.
 /// @return Le dictionnaire créé.
 Dict *Dict_create();
 
+/// @brief Crée un dictionnaire contenant un ensemble de couples clé/valeur.
+/// Le résultat est le même qu'en insérant les couples un par un dans l'ordre
+/// du tableau : si une clé apparaît plusieurs fois, la dernière valeur est
+/// conservée.
+/// Avec l'AVL, les couples sont triés par clé (s'ils ne le sont pas déjà)
+/// puis l'arbre est construit directement, parfaitement équilibré, sans
+/// rotation. Avec la table de hachage, la table est dimensionnée une seule
+/// fois avant les insertions.
+/// Cette méthode s'exécute en O(n) si les clés sont triées, en O(n log n)
+/// sinon.
+/// @param pairs le tableau des couples (il n'est pas modifié).
+/// @param count le nombre de couples.
+/// @return Le dictionnaire créé.
+Dict *Dict_createFromArray(const KVPair *pairs, int count);
+
 /// @brief Détruit un dictionnaire créé avec Dict_create().
 /// @param dict le dictionnaire.
 void Dict_destroy(Dict *dict);
@@ -84,11 +139,18 @@ void *Dict_insert(Dict *dict, char *key, void *value);
 void *Dict_remove(Dict *dict, char *key);
 
 /// @brief Structure représentant un itérateur pour un dictionnaire.
+/// Avec l'AVL, les clés sont parcourues dans l'ordre lexicographique.
+/// Avec la table de hachage (_DICT_HASH), l'ordre de parcours n'est pas
+/// spécifié et les couples renvoyés ne sont plus valides après une insertion.
 typedef struct DictIter_s
 {
     Dict *dict;
+#ifdef _DICT_HASH
+    int index;
+#else
     DictNode *curr;
     bool first;
+#endif
 } DictIter;
 
 /// @brief Initialise un itérateur sur un dictionnaire.
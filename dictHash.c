@@ -0,0 +1,240 @@
+#include "dict.h"
+
+#ifdef _DICT_HASH
+
+/// @brief Capacité initiale de la table.
+#define DICT_MIN_CAPACITY 16
+
+/// @brief Calcule la valeur de hachage d'une clé (FNV-1a).
+/// La valeur 0 est réservée aux cases vides.
+INLINE uint32_t Dict_hash(const char *key, size_t *length)
+{
+    uint32_t hash = 2166136261u;
+    const char *curr = key;
+    for (; *curr; curr++)
+    {
+        hash ^= (unsigned char)*curr;
+        hash *= 16777619u;
+    }
+    if (length) *length = (size_t)(curr - key);
+    return hash ? hash : 1;
+}
+
+/// @brief Cherche la case d'une clé ou la case vide où l'insérer.
+/// @return L'indice de la case.
+INLINE int Dict_probe(Dict *dict, const char *key, uint32_t hash)
+{
+    int mask = dict->capacity - 1;
+    int index = (int)(hash & mask);
+    while (true)
+    {
+        DictEntry *entry = &dict->entries[index];
+        if (entry->hash == 0)
+            return index;
+        if (entry->hash == hash && strcmp(entry->pair.key, key) == 0)
+            return index;
+        index = (index + 1) & mask;
+    }
+}
+
+/// @brief Redimensionne la table et replace toutes les clés.
+void Dict_resize(Dict *dict, int capacity)
+{
+    DictEntry *entries = dict->entries;
+    int oldCapacity = dict->capacity;
+
+    dict->entries = (DictEntry *)calloc(capacity, sizeof(DictEntry));
+    AssertNew(dict->entries);
+    dict->capacity = capacity;
+
+    int mask = capacity - 1;
+    for (int i = 0; i < oldCapacity; i++)
+    {
+        if (entries[i].hash == 0)
+            continue;
+        int index = (int)(entries[i].hash & mask);
+        while (dict->entries[index].hash != 0)
+            index = (index + 1) & mask;
+        dict->entries[index] = entries[i];
+    }
+    free(entries);
+}
+
+Dict *Dict_create()
+{
+    Dict *dict = (Dict *)calloc(1, sizeof(Dict));
+    AssertNew(dict);
+
+    dict->entries = (DictEntry *)calloc(DICT_MIN_CAPACITY, sizeof(DictEntry));
+    AssertNew(dict->entries);
+    dict->capacity = DICT_MIN_CAPACITY;
+    dict->keys = Arena_create(0);
+
+    return dict;
+}
+
+Dict *Dict_createFromArray(const KVPair *pairs, int count)
+{
+    Dict *dict = Dict_create();
+
+    int capacity = DICT_MIN_CAPACITY;
+    while (3 * capacity < 4 * count)
+        capacity *= 2;
+    if (capacity > dict->capacity)
+        Dict_resize(dict, capacity);
+
+    for (int i = 0; i < count; i++)
+    {
+        Dict_insert(dict, pairs[i].key, pairs[i].value);
+    }
+    return dict;
+}
+
+void Dict_destroy(Dict *dict)
+{
+    if (!dict) return;
+
+    Arena_destroy(dict->keys);
+    free(dict->entries);
+    free(dict);
+}
+
+int Dict_size(Dict *dict)
+{
+    assert(dict);
+    return dict->size;
+}
+
+void *Dict_get(Dict *dict, char *key)
+{
+    uint32_t hash = Dict_hash(key, NULL);
+    DictEntry *entry = &dict->entries[Dict_probe(dict, key, hash)];
+    return entry->hash ? entry->pair.value : NULL;
+}
+
+void *Dict_insert(Dict *dict, char *key, void *value)
+{
+    size_t length = 0;
+    uint32_t hash = Dict_hash(key, &length);
+    DictEntry *entry = &dict->entries[Dict_probe(dict, key, hash)];
+
+    if (entry->hash)
+    {
+        // La clé est déjà présente, on remplace la valeur
+        void *prevValue = entry->pair.value;
+        entry->pair.value = value;
+        return prevValue;
+    }
+
+    // On garde un taux de remplissage inférieur à 3/4
+    if (4 * (dict->size + 1) > 3 * dict->capacity)
+    {
+        Dict_resize(dict, 2 * dict->capacity);
+        entry = &dict->entries[Dict_probe(dict, key, hash)];
+    }
+
+    entry->hash = hash;
+    entry->pair.key = Arena_strndup(dict->keys, key, length);
+    entry->pair.value = value;
+    dict->size++;
+
+    return NULL;
+}
+
+void *Dict_remove(Dict *dict, char *key)
+{
+    uint32_t hash = Dict_hash(key, NULL);
+    int index = Dict_probe(dict, key, hash);
+    DictEntry *entries = dict->entries;
+
+    if (entries[index].hash == 0)
+        return NULL;
+
+    void *prevValue = entries[index].pair.value;
+    dict->size--;
+
+    // Suppression par décalage arrière : les clés suivantes de la même suite
+    // de sondage sont rapprochées de leur case idéale, sans marqueur de
+    // suppression.
+    int mask = dict->capacity - 1;
+    int hole = index;
+    int curr = (index + 1) & mask;
+    while (entries[curr].hash != 0)
+    {
+        int ideal = (int)(entries[curr].hash & mask);
+        // La clé peut être déplacée si sa case idéale n'est pas entre le trou
+        // (exclu) et sa position (incluse), de manière circulaire.
+        if (((curr - ideal) & mask) >= ((curr - hole) & mask))
+        {
+            entries[hole] = entries[curr];
+            hole = curr;
+        }
+        curr = (curr + 1) & mask;
+    }
+    entries[hole].hash = 0;
+    entries[hole].pair.key = NULL;
+    entries[hole].pair.value = NULL;
+
+    return prevValue;
+}
+
+void Dict_getIterator(Dict *dict, DictIter *iter)
+{
+    iter->dict = dict;
+    iter->index = 0;
+    while (iter->index < dict->capacity && dict->entries[iter->index].hash == 0)
+        iter->index++;
+}
+
+KVPair *DictIter_next(DictIter *iter)
+{
+    Dict *dict = iter->dict;
+    if (iter->index >= dict->capacity)
+    {
+        return NULL;
+    }
+
+    KVPair *pair = &(dict->entries[iter->index].pair);
+
+    iter->index++;
+    while (iter->index < dict->capacity && dict->entries[iter->index].hash == 0)
+        iter->index++;
+
+    return pair;
+}
+
+bool DictIter_hasNext(DictIter *iter)
+{
+    return iter->index < iter->dict->capacity;
+}
+
+void Dict_print(Dict *dict)
+{
+    printf("size = %d\n", dict->size);
+    for (int i = 0; i < dict->capacity; i++)
+    {
+        DictEntry *entry = &dict->entries[i];
+        if (entry->hash)
+            printf("  \"%s\": %p,\n", entry->pair.key, entry->pair.value);
+    }
+}
+
+void Dict_printTree(Dict *dict)
+{
+    int mask = dict->capacity - 1;
+    for (int i = 0; i < dict->capacity; i++)
+    {
+        DictEntry *entry = &dict->entries[i];
+        if (entry->hash)
+        {
+            int distance = (i - (int)(entry->hash & mask)) & mask;
+            printf("[%d] %s (+%d)\n", i, entry->pair.key, distance);
+        }
+        else
+        {
+            printf("[%d]\n", i);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,180 @@
+#include "frozenDict.h"
+
+/// @brief Renvoie les huit premiers octets d'une clé sous forme d'entier
+/// gros-boutiste complété par des zéros.
+INLINE uint64_t FrozenDict_prefix(const char *key)
+{
+    uint64_t prefix = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        prefix <<= 8;
+        if (*key)
+            prefix |= (unsigned char)*key++;
+    }
+    return prefix;
+}
+
+/// @brief Compare la clé d'une case du tableau avec une clé recherchée
+/// (même résultat que strcmp()).
+/// Le préfixe suffit pour les clés de moins de huit caractères : la clé
+/// stockée n'est alors jamais lue.
+INLINE int FrozenDict_compare(const FrozenDict *dict, unsigned int index, const char *key, uint64_t prefix)
+{
+    uint64_t curr = dict->prefixes[index];
+    if (curr != prefix)
+        return curr < prefix ? -1 : 1;
+
+    // Si le dernier octet est nul, les deux clés se terminent dans le préfixe.
+    if ((curr & 0xFF) == 0)
+        return 0;
+    return strcmp(dict->pairs[index].key + 8, key + 8);
+}
+
+/// @brief Précharge une zone mémoire dans le cache.
+INLINE void FrozenDict_prefetch(const void *address)
+{
+#ifdef __GNUC__
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+/// @brief Compare deux couples par clé.
+int KVPair_compare(const void *a, const void *b)
+{
+    return strcmp(((const KVPair *)a)->key, ((const KVPair *)b)->key);
+}
+
+/// @brief Range les couples triés dans le tableau selon la disposition
+/// d'Eytzinger (parcours infixe de l'arbre implicite).
+void FrozenDict_fill(FrozenDict *dict, const KVPair *sorted, int *next, int index)
+{
+    if (index > dict->size) return;
+
+    FrozenDict_fill(dict, sorted, next, 2 * index);
+    dict->pairs[index] = sorted[(*next)++];
+    FrozenDict_fill(dict, sorted, next, 2 * index + 1);
+}
+
+FrozenDict *Dict_freeze(Dict *dict)
+{
+    FrozenDict *frozen = (FrozenDict *)calloc(1, sizeof(FrozenDict));
+    AssertNew(frozen);
+
+    int size = Dict_size(dict);
+    KVPair *sorted = (KVPair *)calloc(size > 0 ? size : 1, sizeof(KVPair));
+    AssertNew(sorted);
+
+    // Copie des couples et calcul de la taille totale des clés.
+    size_t keysSize = 0;
+    bool isSorted = true;
+    int count = 0;
+    DictIter iter;
+    Dict_getIterator(dict, &iter);
+    while (DictIter_hasNext(&iter) && count < size)
+    {
+        KVPair *pair = DictIter_next(&iter);
+        if (!pair) continue;
+
+        if (count > 0 && strcmp(sorted[count - 1].key, pair->key) > 0)
+            isSorted = false;
+        sorted[count++] = *pair;
+        keysSize += strlen(pair->key) + 1;
+    }
+    if (!isSorted)
+        qsort(sorted, count, sizeof(KVPair), KVPair_compare);
+
+    frozen->size = count;
+    frozen->pairs = (KVPair *)calloc(count + 1, sizeof(KVPair));
+    frozen->prefixes = (uint64_t *)calloc(count + 1, sizeof(uint64_t));
+    frozen->keys = (char *)calloc(keysSize > 0 ? keysSize : 1, sizeof(char));
+    AssertNew(frozen->pairs);
+    AssertNew(frozen->prefixes);
+    AssertNew(frozen->keys);
+
+    int next = 0;
+    FrozenDict_fill(frozen, sorted, &next, 1);
+    free(sorted);
+
+    // Les clés sont copiées dans l'ordre du tableau : celles des premiers
+    // niveaux, lues à chaque recherche, sont voisines en mémoire.
+    char *key = frozen->keys;
+    for (int i = 1; i <= count; i++)
+    {
+        size_t length = strlen(frozen->pairs[i].key) + 1;
+        Memcpy(key, length, frozen->pairs[i].key, length);
+        frozen->pairs[i].key = key;
+        frozen->prefixes[i] = FrozenDict_prefix(key);
+        key += length;
+    }
+
+    return frozen;
+}
+
+FrozenDict *FrozenDict_createFromArray(const KVPair *pairs, int count)
+{
+    Dict *dict = Dict_createFromArray(pairs, count);
+    FrozenDict *frozen = Dict_freeze(dict);
+    Dict_destroy(dict);
+    return frozen;
+}
+
+void FrozenDict_destroy(FrozenDict *dict)
+{
+    if (!dict) return;
+
+    free(dict->pairs);
+    free(dict->prefixes);
+    free(dict->keys);
+    free(dict);
+}
+
+int FrozenDict_size(const FrozenDict *dict)
+{
+    return dict->size;
+}
+
+void *FrozenDict_get(const FrozenDict *dict, const char *key)
+{
+    uint64_t prefix = FrozenDict_prefix(key);
+    unsigned int size = (unsigned int)dict->size;
+    unsigned int index = 1;
+
+    // Descente sans branchement dépendant des données : on va à droite si la
+    // clé de la case est inférieure à la clé recherchée.
+    // Les descendants de la case situés trois niveaux plus bas sont contigus.
+    while (index <= size)
+    {
+        FrozenDict_prefetch(dict->prefixes + 8 * index);
+        index = 2 * index + (FrozenDict_compare(dict, index, key, prefix) < 0);
+    }
+
+    // On remonte jusqu'au dernier noeud où la descente est allée à gauche :
+    // c'est la plus petite clé supérieure ou égale à la clé recherchée.
+    while (index & 1)
+        index >>= 1;
+    index >>= 1;
+
+    if (index == 0 || FrozenDict_compare(dict, index, key, prefix) != 0)
+        return NULL;
+    return dict->pairs[index].value;
+}
+
+void FrozenDict_getIterator(const FrozenDict *dict, FrozenDictIter *iter)
+{
+    iter->dict = dict;
+    iter->index = 1;
+}
+
+const KVPair *FrozenDictIter_next(FrozenDictIter *iter)
+{
+    if (iter->index > iter->dict->size)
+        return NULL;
+    return &iter->dict->pairs[iter->index++];
+}
+
+bool FrozenDictIter_hasNext(FrozenDictIter *iter)
+{
+    return iter->index <= iter->dict->size;
+}
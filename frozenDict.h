@@ -0,0 +1,90 @@
+#pragma once
+#include "settings.h"
+#include "dict.h"
+
+/// @brief Structure représentant un dictionnaire figé (en lecture seule).
+/// Les couples sont rangés dans un tableau contigu selon la disposition
+/// d'Eytzinger : la racine de l'arbre binaire de recherche implicite est à
+/// l'indice 1 et les fils du noeud k sont aux indices 2k et 2k + 1.
+/// Une recherche parcourt ainsi le tableau de haut en bas sans suivre de
+/// pointeur, et les niveaux suivants peuvent être préchargés.
+/// Les clés sont copiées dans un unique bloc mémoire.
+/// Un dictionnaire figé n'est jamais modifié après sa création : plusieurs
+/// threads peuvent l'utiliser en même temps sans synchronisation.
+typedef struct FrozenDict_s
+{
+    /// @brief Tableau des couples (de taille size + 1, la case 0 est inutilisée).
+    KVPair *pairs;
+
+    /// @brief Huit premiers octets de chaque clé, lus en gros-boutiste et
+    /// complétés par des zéros, de sorte que la comparaison de deux entiers
+    /// corresponde à la comparaison lexicographique des débuts de clés.
+    uint64_t *prefixes;
+
+    /// @brief Bloc contenant toutes les clés.
+    char *keys;
+
+    /// @brief Taille du dictionnaire.
+    int size;
+} FrozenDict;
+
+/// @brief Crée un dictionnaire figé contenant les mêmes couples qu'un
+/// dictionnaire.
+/// Les clés sont copiées : le dictionnaire d'origine peut être détruit ou
+/// modifié ensuite sans effet sur le dictionnaire figé.
+/// Cette méthode s'exécute en O(n) si le dictionnaire est parcouru dans
+/// l'ordre des clés (AVL), en O(n log n) sinon.
+/// @param dict le dictionnaire.
+/// @return Le dictionnaire figé.
+FrozenDict *Dict_freeze(Dict *dict);
+
+/// @brief Crée un dictionnaire figé à partir d'un ensemble de couples
+/// clé/valeur (voir Dict_createFromArray()).
+/// @param pairs le tableau des couples (il n'est pas modifié).
+/// @param count le nombre de couples.
+/// @return Le dictionnaire figé.
+FrozenDict *FrozenDict_createFromArray(const KVPair *pairs, int count);
+
+/// @brief Détruit un dictionnaire figé créé avec Dict_freeze() ou
+/// FrozenDict_createFromArray().
+/// @param dict le dictionnaire figé.
+void FrozenDict_destroy(FrozenDict *dict);
+
+/// @brief Renvoie la taille d'un dictionnaire figé.
+/// @param dict le dictionnaire figé.
+/// @return La taille du dictionnaire.
+int FrozenDict_size(const FrozenDict *dict);
+
+/// @brief Renvoie la valeur associée à une clé.
+/// Cette méthode s'exécute en O(log n).
+/// @param dict le dictionnaire figé.
+/// @param key la clé recherchée.
+/// @return La valeur associée à la clé ou NULL si la clé n'est pas présente
+/// dans le dictionnaire.
+void *FrozenDict_get(const FrozenDict *dict, const char *key);
+
+/// @brief Structure représentant un itérateur pour un dictionnaire figé.
+/// Les couples sont parcourus dans l'ordre du tableau (et non dans l'ordre
+/// des clés), ce qui correspond à une lecture séquentielle de la mémoire.
+typedef struct FrozenDictIter_s
+{
+    const FrozenDict *dict;
+    int index;
+} FrozenDictIter;
+
+/// @brief Initialise un itérateur sur un dictionnaire figé.
+/// @param dict le dictionnaire figé.
+/// @param iter pointeur vers l'itérateur à initialiser.
+void FrozenDict_getIterator(const FrozenDict *dict, FrozenDictIter *iter);
+
+/// @brief Renvoie le couple clé/valeur associé à la position d'un itérateur
+/// puis avance l'itérateur.
+/// @param iter l'itérateur.
+/// @return Le couple clé/valeur sur lequel est l'itérateur.
+const KVPair *FrozenDictIter_next(FrozenDictIter *iter);
+
+/// @brief Indique s'il reste des éléments à parcourir pour un itérateur.
+/// @param iter l'itérateur.
+/// @return false si l'itérateur a déjà parcouru tout le dictionnaire,
+/// true sinon.
+bool FrozenDictIter_hasNext(FrozenDictIter *iter);
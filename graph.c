@@ -1,4 +1,5 @@
 #include "graph.h"
+#include "intHeap.h"
 
 Graph *Graph_load(char *filename) {
     FILE *input = fopen(filename, "r");
@@ -27,14 +28,15 @@ Graph *Graph_load(char *filename) {
 /// @param explored tableau de booléens indiquant pour chaque identifiant de
 /// noeud s'il a été marqué comme atteint.
 void Graph_dfsPrintRec(Graph *graph, int currID, bool *explored) {
-    int size;
+    ArcIter iter;
     explored[currID] = true;
     printf("%d-", currID);
-    Arc * successors = Graph_getSuccessors(graph, currID, &size);
-    for (int i = 0; i < size; ++i) {
-        if (explored[successors[i].target])
+    Graph_getSuccessorIterator(graph, currID, &iter);
+    while (ArcIter_hasNext(&iter)) {
+        Arc *arc = ArcIter_next(&iter);
+        if (explored[arc->target])
             continue;
-        Graph_dfsPrintRec(graph, successors[i].target, explored);
+        Graph_dfsPrintRec(graph, arc->target, explored);
     }
 }
 
@@ -47,6 +49,7 @@ void Graph_dfsPrint(Graph *graph, int start) {
     bool *explored = calloc(size, sizeof(bool));
     Graph_dfsPrintRec(graph, start ,explored);
     printf("\n");
+    free(explored);
 }
 
 void Graph_bfsPrint(Graph *graph, int start) {
@@ -62,26 +65,31 @@ void Graph_bfsPrint(Graph *graph, int start) {
     while (!IntList_isEmpty(list)){
         int node = IntList_dequeue(list);
         printf("%d-", node);
-        Arc *successors = Graph_getSuccessors(graph, node, &size);
-        for (int i = 0; i < size; ++i) {
-            if (explored[successors[i].target])
+        ArcIter iter;
+        Graph_getSuccessorIterator(graph, node, &iter);
+        while (ArcIter_hasNext(&iter)) {
+            Arc *arc = ArcIter_next(&iter);
+            if (explored[arc->target])
                 continue;
-            IntList_enqueue(list, successors[i].target);
-            explored[successors[i].target] = true;
+            IntList_enqueue(list, arc->target);
+            explored[arc->target] = true;
         }
     }
     printf("\n");
+    IntList_destroy(list);
+    free(explored);
 }
 
 IntTree *Graph_spanningTreeRec(Graph *graph, int current, bool *explored) {
-    int size;
+    ArcIter iter;
     explored[current] = true;
     IntTree *tree = IntTree_create(current);
-    Arc *successors = Graph_getSuccessors(graph, current, &size);
-    for (int i = 0; i < size; ++i) {
-        if (explored[successors[i].target])
+    Graph_getSuccessorIterator(graph, current, &iter);
+    while (ArcIter_hasNext(&iter)) {
+        Arc *arc = ArcIter_next(&iter);
+        if (explored[arc->target])
             continue;
-        IntTree_addChild(tree, Graph_spanningTreeRec(graph, successors[i].target, explored));
+        IntTree_addChild(tree, Graph_spanningTreeRec(graph, arc->target, explored));
     }
     return tree;
 }
@@ -93,7 +101,9 @@ IntTree *Graph_spanningTree(Graph *graph, int start) {
     }
     int size = Graph_size(graph);
     bool *explored = calloc(size, sizeof(bool));
-    return Graph_spanningTreeRec(graph, start ,explored);
+    IntTree *tree = Graph_spanningTreeRec(graph, start ,explored);
+    free(explored);
+    return tree;
 }
 
 
@@ -127,45 +137,37 @@ void Graph_dijkstra(Graph* graph, int start, int end, int* predecessors, float*
     }
     distances[start] = 0;
 
-    while (true)
+    // Le tas contient les noeuds atteints mais pas encore explorés,
+    // ordonnés selon leur distance provisoire.
+    IntHeap* heap = IntHeap_create(size);
+    IntHeap_push(heap, start, 0.0f);
+
+    while (!IntHeap_isEmpty(heap))
     {
-        int u = -1;
-        float min = INFINITY;
-        for (int i = 0; i < size; i++)
-        {
-            if (distances[i] < min && expl[i] == false)
-            {
-                u = i;
-                min = distances[i];
-            }
-        }
-        if (min == INFINITY)
-        {
-            break;
-        }
-        assert(u >= 0);
+        int u = IntHeap_popMin(heap);
         expl[u] = true;
 
-
         if (u == end)
         {
             break;
         }
 
-        int sizen;
-        Arc* succ = Graph_getSuccessors(graph, u, &sizen);
-        for (int i = 0; i < sizen; i++) {
-            float poids = distances[u] + Graph_get(graph, u, succ[i].target);
-            int v = succ[i].target;
+        ArcIter iter;
+        Graph_getSuccessorIterator(graph, u, &iter);
+        while (ArcIter_hasNext(&iter)) {
+            Arc* arc = ArcIter_next(&iter);
+            int v = arc->target;
             if (expl[v] != true) {
+                float poids = distances[u] + arc->weight;
                 if (poids < distances[v]) {
                     distances[v] = poids;
                     predecessors[v] = u;
+                    IntHeap_push(heap, v, poids);
                 }
             }
         }
-        free(succ);
     }
+    IntHeap_destroy(heap);
     free(expl);
 }
 
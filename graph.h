@@ -5,6 +5,8 @@
 #include "path.h"
 
 //#define _GRAPH_MAT
+//#define _GRAPH_CSR
+//#define _GRAPH_SPARSE_MAT
 
 /// @brief Structure représentant un arc dans un graphe.
 typedef struct sArc
@@ -23,8 +25,15 @@ typedef struct sArc
 //  Fonctions dépendantes de l'implémentation
 
 /// @brief Structure représentant un graphe orienté.
-/// Deux implémentations sont disponibles, soit avec une matrice d'adjacence,
-/// soit avec une liste d'adjacence.
+/// Quatre implémentations sont disponibles, soit avec une matrice d'adjacence
+/// (_GRAPH_MAT), soit avec une liste d'adjacence (par défaut), soit au format
+/// CSR (_GRAPH_CSR) où les arcs sont stockés dans des tableaux contigus, soit
+/// avec une matrice d'adjacence creuse (_GRAPH_SPARSE_MAT) dont chaque ligne
+/// est un ensemble de blocs de 64 bits : elle occupe O(n + m) en mémoire au
+/// lieu de O(n²) pour la matrice dense.
+/// Avec le format CSR, les ajouts et suppressions d'arcs sont fusionnés lors
+/// de la lecture suivante du graphe : il est donc préférable de créer tous les
+/// arcs avant de le parcourir.
 typedef struct sGraph Graph;
 
 /// @brief Crée un nouveau graphe.
@@ -34,6 +43,21 @@ typedef struct sGraph Graph;
 /// @return Le graphe créé.
 Graph *Graph_create(int size);
 
+/// @brief Crée un graphe à partir de tableaux au format CSR (compressed sparse
+/// row) : les arcs sortants du noeud u ont pour cibles targets[offsets[u]] à
+/// targets[offsets[u + 1] - 1] et pour poids les cases correspondantes de
+/// weights. Les cibles de chaque noeud doivent être triées.
+/// Avec l'implémentation CSR, les tableaux sont utilisés directement sans être
+/// copiés : ils doivent rester valides pendant toute la durée de vie du graphe
+/// et ne sont copiés qu'à la première modification du graphe. Les autres
+/// implémentations copient les arcs.
+/// @param size Le nombre de noeuds du graphe.
+/// @param offsets tableau de size + 1 entiers.
+/// @param targets tableau des cibles des arcs.
+/// @param weights tableau des poids des arcs.
+/// @return Le graphe créé.
+Graph *Graph_createCsr(int size, int *offsets, int *targets, float *weights);
+
 /// @brief Détruit un graphe créé avec Graph_create().
 /// @param graph le graphe.
 void Graph_destroy(Graph *graph);
@@ -91,6 +115,62 @@ Arc *Graph_getPredecessors(Graph *graph, int u, int *size);
 /// @return Le tableau contenant les arcs partant du noeud u.
 Arc *Graph_getSuccessors(Graph *graph, int u, int *size);
 
+/// @brief Structure représentant un itérateur sur les arcs d'un noeud.
+/// Contrairement à Graph_getSuccessors() et Graph_getPredecessors(), un
+/// itérateur parcourt les arcs sur place, sans allocation.
+/// L'interprétation des champs curr, index et end dépend de l'implémentation.
+/// Le graphe ne doit pas être modifié pendant le parcours, à l'exception du
+/// poids des arcs existants.
+typedef struct sArcIter
+{
+    /// @brief Graphe parcouru.
+    Graph *graph;
+
+    /// @brief Identifiant du noeud dont on parcourt les arcs.
+    int node;
+
+    /// @brief Position courante dans la structure du graphe.
+    void *curr;
+
+    /// @brief Indice courant dans la structure du graphe.
+    int index;
+
+    /// @brief Indice de fin dans la structure du graphe.
+    int end;
+
+    /// @brief true si l'itérateur parcourt les arcs entrants,
+    /// false s'il parcourt les arcs sortants.
+    bool reverse;
+
+    /// @brief Arc renvoyé par le dernier appel à ArcIter_next().
+    Arc arc;
+} ArcIter;
+
+/// @brief Initialise un itérateur sur les arcs partant d'un noeud.
+/// @param graph le graphe.
+/// @param u l'identifiant du noeud de départ.
+/// @param iter pointeur vers l'itérateur à initialiser.
+void Graph_getSuccessorIterator(Graph *graph, int u, ArcIter *iter);
+
+/// @brief Initialise un itérateur sur les arcs arrivant à un noeud.
+/// @param graph le graphe.
+/// @param u l'identifiant du noeud d'arrivée.
+/// @param iter pointeur vers l'itérateur à initialiser.
+void Graph_getPredecessorIterator(Graph *graph, int u, ArcIter *iter);
+
+/// @brief Indique s'il reste des arcs à parcourir pour un itérateur.
+/// @param iter l'itérateur.
+/// @return false si l'itérateur a déjà parcouru tous les arcs,
+/// true sinon.
+bool ArcIter_hasNext(ArcIter *iter);
+
+/// @brief Renvoie l'arc associé à la position d'un itérateur puis avance
+/// l'itérateur.
+/// Le pointeur renvoyé reste valide jusqu'au prochain appel.
+/// @param iter l'itérateur.
+/// @return L'arc sur lequel est l'itérateur.
+Arc *ArcIter_next(ArcIter *iter);
+
 //------------------------------------------------------------------------------
 //  Fonctions communes
 
@@ -122,7 +202,8 @@ IntTree* Graph_spanningTree(Graph* graph, int start);
 /// @brief Renvoie un plus court chemin entre deux sommets d'un graphe.
 /// Si aucun chemin n'existe, renvoie NULL.
 /// Cette fonction suit l'algorithme de Dijkstra.
-/// Elle a une complexité en O(n^2) où n désigne le nombre de noeuds du graphe.
+/// Elle a une complexité en O((n + m) log n) où n désigne le nombre de noeuds
+/// et m le nombre d'arcs du graphe.
 ///
 /// @param graph le graphe.
 /// @param start l'identifiant du sommet de départ.
@@ -131,6 +212,8 @@ IntTree* Graph_spanningTree(Graph* graph, int start);
 Path* Graph_shortestPath(Graph* graph, int start, int end);
 
 /// @brief Effectue l'algorithme de Dijkstra.
+/// Le prochain noeud à explorer est extrait d'un tas binaire indexé (IntHeap)
+/// au lieu d'être recherché parmi tous les noeuds.
 /// Si end >= 0, cette fonction calcule un plus court chemin entre les noeuds
 /// start et end.
 /// Le chemin doit cependant être reconstruit à partir des tableaux
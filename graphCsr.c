@@ -0,0 +1,448 @@
+#include "graph.h"
+
+#ifdef _GRAPH_CSR
+
+typedef struct sGraph Graph;
+
+/// @brief Structure représentant une modification d'arc en attente.
+typedef struct sPendingArc {
+    /// @brief Arc à définir (ou à supprimer si son poids est négatif).
+    Arc arc;
+    /// @brief Ordre d'arrivée de la modification.
+    int order;
+} PendingArc;
+
+/// @brief Graphe stocké au format CSR (compressed sparse row).
+/// Les arcs sortants du noeud u sont rangés, triés par cible, dans les cases
+/// offsets[u] à offsets[u + 1] - 1 des tableaux targets et weights.
+/// Les ajouts et suppressions d'arcs sont mis en attente puis fusionnés en une
+/// seule fois lors de la lecture suivante du graphe. La modification du poids
+/// d'un arc existant se fait directement sur place.
+/// L'index des arcs entrants n'est construit qu'au premier accès aux
+/// prédécesseurs.
+struct sGraph {
+    /// @brief Début des arcs sortants de chaque noeud (size + 1 cases).
+    int *offsets;
+    /// @brief Cible de chaque arc.
+    int *targets;
+    /// @brief Poids de chaque arc.
+    float *weights;
+    /// @brief Début des arcs entrants de chaque noeud (size + 1 cases).
+    int *inOffsets;
+    /// @brief Indice dans targets/weights de chaque arc entrant.
+    int *inArcs;
+    /// @brief Source de chaque arc entrant.
+    int *inSources;
+    /// @brief Indique si l'index des arcs entrants est à jour.
+    bool hasInArcs;
+    /// @brief Indique si les tableaux offsets, targets et weights sont
+    /// empruntés (Graph_createCsr()) et ne doivent pas être libérés.
+    bool borrowed;
+    /// @brief Nombre d'arcs du graphe.
+    int arcCount;
+    /// @brief Nombre de noeuds du graphe.
+    int size;
+    /// @brief Modifications en attente de fusion.
+    PendingArc *pending;
+    /// @brief Nombre de modifications en attente.
+    int pendingCount;
+    /// @brief Capacité du tableau des modifications en attente.
+    int pendingCapacity;
+};
+
+Graph *Graph_create(int size) {
+    if (size < 1) return NULL;
+    Graph *graph = calloc(1, sizeof(Graph));
+    AssertNew(graph);
+    graph->offsets = calloc(size + 1, sizeof(int));
+    graph->inOffsets = calloc(size + 1, sizeof(int));
+    AssertNew(graph->offsets);
+    AssertNew(graph->inOffsets);
+    graph->size = size;
+    return graph;
+}
+
+Graph *Graph_createCsr(int size, int *offsets, int *targets, float *weights) {
+    if (size < 1) return NULL;
+    Graph *graph = calloc(1, sizeof(Graph));
+    AssertNew(graph);
+    graph->inOffsets = calloc(size + 1, sizeof(int));
+    AssertNew(graph->inOffsets);
+    graph->offsets = offsets;
+    graph->targets = targets;
+    graph->weights = weights;
+    graph->arcCount = offsets[size];
+    graph->size = size;
+    graph->borrowed = true;
+    return graph;
+}
+
+/// @brief Copie les tableaux empruntés d'un graphe créé avec
+/// Graph_createCsr() avant sa première modification.
+void Graph_detach(Graph *graph) {
+    if (!graph->borrowed)
+        return;
+    int size = graph->size, arcCount = graph->arcCount;
+    int *offsets = calloc(size + 1, sizeof(int));
+    int *targets = calloc(arcCount > 0 ? arcCount : 1, sizeof(int));
+    float *weights = calloc(arcCount > 0 ? arcCount : 1, sizeof(float));
+    AssertNew(offsets);
+    AssertNew(targets);
+    AssertNew(weights);
+    memcpy(offsets, graph->offsets, (size + 1) * sizeof(int));
+    memcpy(targets, graph->targets, arcCount * sizeof(int));
+    memcpy(weights, graph->weights, arcCount * sizeof(float));
+    graph->offsets = offsets;
+    graph->targets = targets;
+    graph->weights = weights;
+    graph->borrowed = false;
+}
+
+void Graph_destroy(Graph *graph) {
+    assert(graph);
+    if (!graph->borrowed) {
+        free(graph->offsets);
+        free(graph->targets);
+        free(graph->weights);
+    }
+    free(graph->inOffsets);
+    free(graph->inArcs);
+    free(graph->inSources);
+    free(graph->pending);
+    free(graph);
+}
+
+int Graph_size(Graph *graph) {
+    assert(graph);
+    return graph->size;
+}
+
+/// @brief Compare deux modifications selon leur source, leur cible puis leur
+/// ordre d'arrivée.
+int PendingArc_compare(const void *a, const void *b) {
+    const PendingArc *pa = a;
+    const PendingArc *pb = b;
+    if (pa->arc.source != pb->arc.source)
+        return pa->arc.source < pb->arc.source ? -1 : 1;
+    if (pa->arc.target != pb->arc.target)
+        return pa->arc.target < pb->arc.target ? -1 : 1;
+    return pa->order < pb->order ? -1 : (pa->order > pb->order);
+}
+
+/// @brief Recherche un arc dans la ligne d'un noeud.
+/// @return L'indice de l'arc dans targets/weights, -1 s'il n'existe pas.
+int Graph_findArc(Graph *graph, int u, int v) {
+    int lo = graph->offsets[u];
+    int hi = graph->offsets[u + 1] - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        int target = graph->targets[mid];
+        if (target == v)
+            return mid;
+        if (target < v)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return -1;
+}
+
+/// @brief Reconstruit l'index des arcs entrants à partir des lignes CSR.
+void Graph_buildInArcs(Graph *graph) {
+    int size = graph->size;
+    free(graph->inArcs);
+    free(graph->inSources);
+    graph->inArcs = calloc(graph->arcCount > 0 ? graph->arcCount : 1, sizeof(int));
+    graph->inSources = calloc(graph->arcCount > 0 ? graph->arcCount : 1, sizeof(int));
+    AssertNew(graph->inArcs);
+    AssertNew(graph->inSources);
+
+    memset(graph->inOffsets, 0, (size + 1) * sizeof(int));
+    for (int i = 0; i < graph->arcCount; ++i)
+        graph->inOffsets[graph->targets[i] + 1]++;
+    for (int i = 0; i < size; ++i)
+        graph->inOffsets[i + 1] += graph->inOffsets[i];
+
+    // Les sources sont parcourues dans l'ordre croissant, les arcs entrants de
+    // chaque noeud sont donc triés par source.
+    int *cursor = calloc(size, sizeof(int));
+    AssertNew(cursor);
+    memcpy(cursor, graph->inOffsets, size * sizeof(int));
+    for (int u = 0; u < size; ++u) {
+        for (int i = graph->offsets[u]; i < graph->offsets[u + 1]; ++i) {
+            int idx = cursor[graph->targets[i]]++;
+            graph->inArcs[idx] = i;
+            graph->inSources[idx] = u;
+        }
+    }
+    free(cursor);
+    graph->hasInArcs = true;
+}
+
+/// @brief Fusionne les modifications en attente dans les tableaux CSR.
+/// Pour un même arc, seule la dernière modification est conservée.
+void Graph_compact(Graph *graph) {
+    if (graph->pendingCount == 0)
+        return;
+
+    int size = graph->size;
+    PendingArc *pending = graph->pending;
+    int pendingCount = graph->pendingCount;
+    qsort(pending, pendingCount, sizeof(PendingArc), PendingArc_compare);
+
+    // On ne garde que la dernière modification de chaque arc.
+    int unique = 0;
+    for (int i = 0; i < pendingCount; ++i) {
+        if (i + 1 < pendingCount &&
+            pending[i + 1].arc.source == pending[i].arc.source &&
+            pending[i + 1].arc.target == pending[i].arc.target)
+            continue;
+        pending[unique++] = pending[i];
+    }
+
+    int capacity = graph->arcCount + unique;
+    int *offsets = calloc(size + 1, sizeof(int));
+    int *targets = calloc(capacity > 0 ? capacity : 1, sizeof(int));
+    float *weights = calloc(capacity > 0 ? capacity : 1, sizeof(float));
+    AssertNew(offsets);
+    AssertNew(targets);
+    AssertNew(weights);
+
+    // Fusion ligne par ligne des arcs existants (triés) et des modifications (triées).
+    int count = 0, p = 0;
+    for (int u = 0; u < size; ++u) {
+        offsets[u] = count;
+        int i = graph->offsets[u], end = graph->offsets[u + 1];
+        while (i < end || (p < unique && pending[p].arc.source == u)) {
+            bool hasPending = p < unique && pending[p].arc.source == u;
+            if (!hasPending || (i < end && graph->targets[i] < pending[p].arc.target)) {
+                targets[count] = graph->targets[i];
+                weights[count] = graph->weights[i];
+                count++; i++;
+                continue;
+            }
+            if (i < end && graph->targets[i] == pending[p].arc.target)
+                i++;
+            if (pending[p].arc.weight >= 0.0f) {
+                targets[count] = pending[p].arc.target;
+                weights[count] = pending[p].arc.weight;
+                count++;
+            }
+            p++;
+        }
+    }
+    offsets[size] = count;
+
+    if (!graph->borrowed) {
+        free(graph->offsets);
+        free(graph->targets);
+        free(graph->weights);
+    }
+    graph->offsets = offsets;
+    graph->targets = targets;
+    graph->weights = weights;
+    graph->arcCount = count;
+    graph->borrowed = false;
+    graph->hasInArcs = false;
+
+    free(graph->pending);
+    graph->pending = NULL;
+    graph->pendingCount = 0;
+    graph->pendingCapacity = 0;
+}
+
+/// @brief Fusionne les modifications en attente puis construit l'index des
+/// arcs entrants s'il n'est pas à jour.
+void Graph_compactInArcs(Graph *graph) {
+    Graph_compact(graph);
+    if (!graph->hasInArcs)
+        Graph_buildInArcs(graph);
+}
+
+void Graph_print(Graph *graph) {
+    if (!graph) {
+        printf("ERROR: Invalid graph provided\n");
+        return;
+    }
+    Graph_compact(graph);
+    printf("Node count : %d\n\n", graph->size);
+    for (int u = 0; u < graph->size; ++u) {
+        printf("Node %d", u);
+        printf(" (d+%d) ", Graph_getPositiveValency(graph, u));
+        printf(" (d-%d) ", Graph_getNegativeValency(graph, u));
+        for (int i = graph->offsets[u]; i < graph->offsets[u + 1]; ++i) {
+            printf("[%f, %d, %d]", graph->weights[i], u, graph->targets[i]);
+        }
+        printf("\n");
+    }
+}
+
+/// @brief Ajoute une modification à la liste d'attente.
+void Graph_addPending(Graph *graph, int u, int v, float weight) {
+    if (graph->pendingCount >= graph->pendingCapacity) {
+        int capacity = graph->pendingCapacity > 0 ? 2 * graph->pendingCapacity : 64;
+        PendingArc *pending = realloc(graph->pending, capacity * sizeof(PendingArc));
+        AssertNew(pending);
+        graph->pending = pending;
+        graph->pendingCapacity = capacity;
+    }
+    PendingArc *arc = &graph->pending[graph->pendingCount];
+    arc->arc.source = u;
+    arc->arc.target = v;
+    arc->arc.weight = weight;
+    arc->order = graph->pendingCount++;
+}
+
+void Graph_set(Graph *graph, int u, int v, float weight) {
+    if (!graph) {
+        printf("ERROR : Invalid graph provided\n");
+        return;
+    }
+    if (u < 0 || v < 0 || u >= graph->size || v >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return;
+    }
+
+    // Si aucune modification n'est en attente, les tableaux CSR sont à jour :
+    // on modifie directement le poids d'un arc existant.
+    if (graph->pendingCount == 0) {
+        int idx = Graph_findArc(graph, u, v);
+        if (idx >= 0 && weight >= 0.0f) {
+            Graph_detach(graph);
+            graph->weights[idx] = weight;
+            return;
+        }
+        if (idx < 0 && weight < 0.0f)
+            return;
+    }
+    Graph_addPending(graph, u, v, weight);
+}
+
+float Graph_get(Graph *graph, int u, int v) {
+    if (!graph) {
+        printf("ERROR : Invalid graph provided\n");
+        return -1.f;
+    }
+    if (u < 0 || v < 0 || u >= graph->size || v >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return -1.f;
+    }
+    Graph_compact(graph);
+    int idx = Graph_findArc(graph, u, v);
+    return idx >= 0 ? graph->weights[idx] : -1.f;
+}
+
+int Graph_getPositiveValency(Graph *graph, int u) {
+    if (!graph) {
+        printf("ERROR : Invalid graph provided\n");
+        return -1;
+    }
+    if (u < 0 || u >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return -1;
+    }
+    Graph_compact(graph);
+    return graph->offsets[u + 1] - graph->offsets[u];
+}
+
+int Graph_getNegativeValency(Graph *graph, int u) {
+    if (!graph) {
+        printf("ERROR : Invalid graph provided\n");
+        return -1;
+    }
+    if (u < 0 || u >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return -1;
+    }
+    Graph_compactInArcs(graph);
+    return graph->inOffsets[u + 1] - graph->inOffsets[u];
+}
+
+Arc *Graph_getPredecessors(Graph *graph, int u, int *size) {
+    if (!graph) {
+        printf("ERROR : Invalid graph provided\n");
+        return NULL;
+    }
+    if (u < 0 || u >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return NULL;
+    }
+    *size = Graph_getNegativeValency(graph, u);
+    if (!(*size))
+        return NULL;
+    Arc *arc = calloc(*size, sizeof(Arc));
+    int start = graph->inOffsets[u];
+    for (int i = 0; i < *size; ++i) {
+        arc[i].source = graph->inSources[start + i];
+        arc[i].target = u;
+        arc[i].weight = graph->weights[graph->inArcs[start + i]];
+    }
+    return arc;
+}
+
+Arc *Graph_getSuccessors(Graph *graph, int u, int *size) {
+    if (!graph) {
+        printf("ERROR : Invalid graph provided\n");
+        return NULL;
+    }
+    if (u < 0 || u >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return NULL;
+    }
+    *size = Graph_getPositiveValency(graph, u);
+    if (!(*size))
+        return NULL;
+    Arc *arc = calloc(*size, sizeof(Arc));
+    int start = graph->offsets[u];
+    for (int i = 0; i < *size; ++i) {
+        arc[i].source = u;
+        arc[i].target = graph->targets[start + i];
+        arc[i].weight = graph->weights[start + i];
+    }
+    return arc;
+}
+
+void Graph_getSuccessorIterator(Graph *graph, int u, ArcIter *iter) {
+    assert(graph && u >= 0 && u < graph->size);
+    Graph_compact(graph);
+    iter->graph = graph;
+    iter->node = u;
+    iter->reverse = false;
+    iter->curr = NULL;
+    iter->index = graph->offsets[u];
+    iter->end = graph->offsets[u + 1];
+}
+
+void Graph_getPredecessorIterator(Graph *graph, int u, ArcIter *iter) {
+    assert(graph && u >= 0 && u < graph->size);
+    Graph_compactInArcs(graph);
+    iter->graph = graph;
+    iter->node = u;
+    iter->reverse = true;
+    iter->curr = NULL;
+    iter->index = graph->inOffsets[u];
+    iter->end = graph->inOffsets[u + 1];
+}
+
+bool ArcIter_hasNext(ArcIter *iter) {
+    return iter->index < iter->end;
+}
+
+Arc *ArcIter_next(ArcIter *iter) {
+    if (iter->index >= iter->end)
+        return NULL;
+    Graph *graph = iter->graph;
+    int i = iter->index++;
+    if (iter->reverse) {
+        iter->arc.source = graph->inSources[i];
+        iter->arc.target = iter->node;
+        iter->arc.weight = graph->weights[graph->inArcs[i]];
+    } else {
+        iter->arc.source = iter->node;
+        iter->arc.target = graph->targets[i];
+        iter->arc.weight = graph->weights[i];
+    }
+    return &iter->arc;
+}
+
+#endif
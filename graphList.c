@@ -1,6 +1,6 @@
 #include "graph.h"
 
-#ifndef _GRAPH_MAT
+#if !defined(_GRAPH_MAT) && !defined(_GRAPH_CSR) && !defined(_GRAPH_SPARSE_MAT)
 
 typedef struct sGraph Graph;
 typedef struct sGraphNode GraphNode;
@@ -24,13 +24,21 @@ struct sGraphNode {
     int positiveValency;
     /// @brief Liste des arcs sortants du noeud.
     ArcList *arcList;
+    /// @brief Liste des arcs entrants du noeud, triés par source.
+    /// Les cellules sont partagées avec les listes des arcs sortants et
+    /// chaînées par leur champ nextIn.
+    ArcList *inArcList;
 };
 
 /// @brief Structure représentant une liste simplement chaînée des arcs sortants d'un noeud.
+/// Chaque cellule appartient également à la liste des arcs entrants de sa cible.
 struct sArcList {
     /// @brief Pointeur vers l'élément suivant de la liste.
     /// Vaut NULL s'il s'agit du dernier élément.
     ArcList *next;
+    /// @brief Pointeur vers l'élément suivant de la liste des arcs entrants
+    /// de la cible. Vaut NULL s'il s'agit du dernier élément.
+    ArcList *nextIn;
     /// @brief Arc associé au noeud de liste.
     Arc arc;
 };
@@ -46,12 +54,46 @@ Graph *Graph_create(int size) {
     return graph;
 }
 
+Graph *Graph_createCsr(int size, int *offsets, int *targets, float *weights) {
+    Graph *graph = Graph_create(size);
+    if (!graph) return NULL;
+    for (int u = 0; u < size; ++u) {
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+            Graph_set(graph, u, targets[i], weights[i]);
+        }
+    }
+    return graph;
+}
+
 void Graph_destroyRec(ArcList *arc) {
-    if (!arc->next) {
+    while (arc) {
+        ArcList *next = arc->next;
         free(arc);
-        return;
+        arc = next;
     }
-    return Graph_destroyRec(arc->next);
+}
+
+/// @brief Insère une cellule dans la liste des arcs entrants de sa cible,
+/// en conservant l'ordre des sources.
+/// @param graph le graphe.
+/// @param arc la cellule à insérer.
+void Graph_linkIn(Graph *graph, ArcList *arc) {
+    ArcList **link = &graph->nodes[arc->arc.target].inArcList;
+    while (*link && (*link)->arc.source < arc->arc.source)
+        link = &(*link)->nextIn;
+    arc->nextIn = *link;
+    *link = arc;
+}
+
+/// @brief Retire une cellule de la liste des arcs entrants de sa cible.
+/// @param graph le graphe.
+/// @param arc la cellule à retirer.
+void Graph_unlinkIn(Graph *graph, ArcList *arc) {
+    ArcList **link = &graph->nodes[arc->arc.target].inArcList;
+    while (*link && *link != arc)
+        link = &(*link)->nextIn;
+    if (*link)
+        *link = arc->nextIn;
 }
 
 void Graph_destroy(Graph *graph) {
@@ -112,6 +154,7 @@ void Graph_set(Graph *graph, int u, int v, float weight) {
         // on le supprime, on actualise les valency et on retourne.
         if (current && current->arc.target == v) {
             graph->nodes[u].arcList = current->next;
+            Graph_unlinkIn(graph, current);
             free(current);
             graph->nodes[u].positiveValency--;
             graph->nodes[v].negativeValency--;
@@ -125,6 +168,7 @@ void Graph_set(Graph *graph, int u, int v, float weight) {
             if (current->next && current->next->arc.target == v) {
                 tmp = current->next;
                 current->next = current->next->next;
+                Graph_unlinkIn(graph, tmp);
                 free(tmp);
                 graph->nodes[u].positiveValency--;
                 graph->nodes[v].negativeValency--;
@@ -158,6 +202,7 @@ void Graph_set(Graph *graph, int u, int v, float weight) {
     arc->arc.source = u;
     arc->arc.target = v;
     arc->arc.weight = weight;
+    Graph_linkIn(graph, arc);
 
     //Si la liste est vite, on insère le nœud en tête, on actualise les valency et on retourne.
     if (!current) {
@@ -240,14 +285,10 @@ Arc *Graph_getPredecessors(Graph *graph, int u, int *size) {
     if (!Graph_getNegativeValency(graph, u))
         return NULL;
     Arc *arc = calloc(Graph_getNegativeValency(graph, u), sizeof(Arc));
-    ArcList *current = NULL;
-    for (int i = 0; i < graph->size; ++i) {
-        current = graph->nodes[i].arcList;
-        while (current) {
-            if (current->arc.target == u)
-                arc[(*size)++] = current->arc;
-            current = current->next;
-        }
+    ArcList *current = graph->nodes[u].inArcList;
+    while (current) {
+        arc[(*size)++] = current->arc;
+        current = current->nextIn;
     }
     return arc;
 }
@@ -274,4 +315,33 @@ Arc *Graph_getSuccessors(Graph *graph, int u, int *size) {
     return arc;
 }
 
+void Graph_getSuccessorIterator(Graph *graph, int u, ArcIter *iter) {
+    assert(graph && u >= 0 && u < graph->size);
+    iter->graph = graph;
+    iter->node = u;
+    iter->reverse = false;
+    iter->curr = graph->nodes[u].arcList;
+}
+
+void Graph_getPredecessorIterator(Graph *graph, int u, ArcIter *iter) {
+    assert(graph && u >= 0 && u < graph->size);
+    iter->graph = graph;
+    iter->node = u;
+    iter->reverse = true;
+    iter->curr = graph->nodes[u].inArcList;
+}
+
+bool ArcIter_hasNext(ArcIter *iter) {
+    return iter->curr != NULL;
+}
+
+Arc *ArcIter_next(ArcIter *iter) {
+    ArcList *current = iter->curr;
+    if (!current)
+        return NULL;
+    iter->arc = current->arc;
+    iter->curr = iter->reverse ? current->nextIn : current->next;
+    return &iter->arc;
+}
+
 #endif
\ No newline at end of file
@@ -29,6 +29,17 @@ Graph *Graph_create(int size) {
     return graph;
 }
 
+Graph *Graph_createCsr(int size, int *offsets, int *targets, float *weights) {
+    Graph *graph = Graph_create(size);
+    if (!graph) return NULL;
+    for (int u = 0; u < size; ++u) {
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+            Graph_set(graph, u, targets[i], weights[i]);
+        }
+    }
+    return graph;
+}
+
 void Graph_destroy(Graph *graph) {
     assert(graph);
     for (int i = 0; i < graph->size; ++i) {
@@ -166,4 +177,61 @@ Arc *Graph_getSuccessors(Graph *graph, int u, int *size) {
     return successors;
 }
 
+/// @brief Place un itérateur sur le prochain arc existant de la ligne
+/// (ou de la colonne) parcourue, à partir de la position courante.
+void ArcIter_seek(ArcIter *iter) {
+    Graph *graph = iter->graph;
+    int u = iter->node;
+    while (iter->index < iter->end) {
+        float weight = iter->reverse ? graph->arcs[iter->index][u] : graph->arcs[u][iter->index];
+        if (weight >= 0.0f)
+            return;
+        iter->index++;
+    }
+}
+
+void Graph_getSuccessorIterator(Graph *graph, int u, ArcIter *iter) {
+    assert(graph && u >= 0 && u < graph->size);
+    iter->graph = graph;
+    iter->node = u;
+    iter->reverse = false;
+    iter->curr = NULL;
+    iter->index = 0;
+    iter->end = graph->positiveValencies[u] > 0 ? graph->size : 0;
+    ArcIter_seek(iter);
+}
+
+void Graph_getPredecessorIterator(Graph *graph, int u, ArcIter *iter) {
+    assert(graph && u >= 0 && u < graph->size);
+    iter->graph = graph;
+    iter->node = u;
+    iter->reverse = true;
+    iter->curr = NULL;
+    iter->index = 0;
+    iter->end = graph->negativeValencies[u] > 0 ? graph->size : 0;
+    ArcIter_seek(iter);
+}
+
+bool ArcIter_hasNext(ArcIter *iter) {
+    return iter->index < iter->end;
+}
+
+Arc *ArcIter_next(ArcIter *iter) {
+    if (iter->index >= iter->end)
+        return NULL;
+    Graph *graph = iter->graph;
+    int i = iter->index++;
+    if (iter->reverse) {
+        iter->arc.source = i;
+        iter->arc.target = iter->node;
+        iter->arc.weight = graph->arcs[i][iter->node];
+    } else {
+        iter->arc.source = iter->node;
+        iter->arc.target = i;
+        iter->arc.weight = graph->arcs[iter->node][i];
+    }
+    ArcIter_seek(iter);
+    return &iter->arc;
+}
+
 #endif
\ No newline at end of file
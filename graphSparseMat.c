@@ -0,0 +1,381 @@
+#include "graph.h"
+
+#ifdef _GRAPH_SPARSE_MAT
+
+typedef struct sGraph Graph;
+
+/// @brief Bloc de 64 colonnes consécutives d'une ligne (ou de 64 lignes
+/// consécutives d'une colonne) de la matrice d'adjacence.
+typedef struct sSparseBlock {
+    /// @brief Indice du bloc : il couvre les cases 64 * index à 64 * index + 63.
+    int index;
+    /// @brief Indice du poids du premier arc du bloc dans le tableau des poids
+    /// de la ligne (inutilisé pour les colonnes).
+    int offset;
+    /// @brief Le bit i vaut 1 si la case 64 * index + i contient un arc.
+    uint64_t mask;
+} SparseBlock;
+
+/// @brief Ligne (ou colonne) creuse de la matrice d'adjacence.
+/// Seuls les blocs contenant au moins un arc sont stockés, triés par indice.
+typedef struct sSparseLine {
+    /// @brief Blocs non vides de la ligne.
+    SparseBlock *blocks;
+    /// @brief Poids des arcs de la ligne dans l'ordre des cases (NULL pour
+    /// les colonnes, dont les poids sont lus dans les lignes).
+    float *weights;
+    /// @brief Nombre de blocs.
+    int blockCount;
+    /// @brief Capacité du tableau des blocs.
+    int blockCapacity;
+    /// @brief Nombre d'arcs de la ligne (degré du noeud).
+    int count;
+    /// @brief Capacité du tableau des poids.
+    int weightCapacity;
+} SparseLine;
+
+/// @brief Graphe stocké comme une matrice d'adjacence creuse.
+/// Chaque ligne est découpée en blocs de 64 colonnes représentés par un
+/// masque de bits ; les poids sont rangés de façon contiguë par ligne. La
+/// mémoire utilisée est en O(n + m) au lieu de O(n²) pour _GRAPH_MAT, et les
+/// successeurs sont obtenus en parcourant les bits des masques.
+/// Les colonnes sont stockées de la même façon (sans les poids) pour
+/// parcourir les prédécesseurs.
+struct sGraph {
+    /// @brief Ligne de chaque noeud (arcs sortants).
+    SparseLine *rows;
+    /// @brief Colonne de chaque noeud (arcs entrants).
+    SparseLine *columns;
+    /// @brief Nombre de noeuds du graphe.
+    int size;
+};
+
+Graph *Graph_create(int size) {
+    if (size < 1) return NULL;
+    Graph *graph = calloc(1, sizeof(Graph));
+    AssertNew(graph);
+    graph->rows = calloc(size, sizeof(SparseLine));
+    graph->columns = calloc(size, sizeof(SparseLine));
+    AssertNew(graph->rows);
+    AssertNew(graph->columns);
+    graph->size = size;
+    return graph;
+}
+
+Graph *Graph_createCsr(int size, int *offsets, int *targets, float *weights) {
+    Graph *graph = Graph_create(size);
+    if (!graph) return NULL;
+    for (int u = 0; u < size; ++u) {
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+            Graph_set(graph, u, targets[i], weights[i]);
+        }
+    }
+    return graph;
+}
+
+void Graph_destroy(Graph *graph) {
+    assert(graph);
+    for (int i = 0; i < graph->size; ++i) {
+        free(graph->rows[i].blocks);
+        free(graph->rows[i].weights);
+        free(graph->columns[i].blocks);
+    }
+    free(graph->rows);
+    free(graph->columns);
+    free(graph);
+}
+
+int Graph_size(Graph *graph) {
+    assert(graph);
+    return graph->size;
+}
+
+/// @brief Recherche le bloc d'indice index d'une ligne.
+/// La recherche est dichotomique parmi les blocs non vides de la ligne, dont
+/// le nombre est borné par le degré du noeud (un ou deux blocs en pratique).
+/// @return La position du bloc dans la ligne s'il existe, sinon l'opposé de
+/// la position où l'insérer moins 1.
+INLINE int SparseLine_findBlock(const SparseLine *line, int index) {
+    int lo = 0, hi = line->blockCount - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        int blockIndex = line->blocks[mid].index;
+        if (blockIndex == index)
+            return mid;
+        if (blockIndex < index)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return -lo - 1;
+}
+
+/// @brief Renvoie la position dans le tableau des poids de l'arc d'une case
+/// (existante) d'un bloc.
+INLINE int SparseBlock_getRank(const SparseBlock *block, int bit) {
+    return block->offset + __builtin_popcountll(block->mask & ((1ull << bit) - 1));
+}
+
+/// @brief Ajoute une case à une ligne.
+/// @return La position du poids de la case dans le tableau des poids.
+int SparseLine_insert(SparseLine *line, int v) {
+    int index = v >> 6, bit = v & 63;
+    int position = SparseLine_findBlock(line, index);
+    if (position < 0) {
+        // Nouveau bloc inséré à sa place.
+        position = -position - 1;
+        if (line->blockCount == line->blockCapacity) {
+            line->blockCapacity = line->blockCapacity ? 2 * line->blockCapacity : 2;
+            line->blocks = realloc(line->blocks, line->blockCapacity * sizeof(SparseBlock));
+            AssertNew(line->blocks);
+        }
+        memmove(line->blocks + position + 1, line->blocks + position,
+                (line->blockCount - position) * sizeof(SparseBlock));
+        line->blocks[position].index = index;
+        line->blocks[position].offset =
+                position < line->blockCount ? line->blocks[position + 1].offset : line->count;
+        line->blocks[position].mask = 0;
+        line->blockCount++;
+    }
+    SparseBlock *block = &line->blocks[position];
+    int rank = SparseBlock_getRank(block, bit);
+    block->mask |= 1ull << bit;
+    for (int i = position + 1; i < line->blockCount; ++i) {
+        line->blocks[i].offset++;
+    }
+    line->count++;
+    return rank;
+}
+
+/// @brief Retire une case (existante) d'une ligne.
+/// @return La position qu'avait le poids de la case dans le tableau des poids.
+int SparseLine_remove(SparseLine *line, int v) {
+    int index = v >> 6, bit = v & 63;
+    int position = SparseLine_findBlock(line, index);
+    assert(position >= 0);
+    SparseBlock *block = &line->blocks[position];
+    int rank = SparseBlock_getRank(block, bit);
+    block->mask &= ~(1ull << bit);
+    for (int i = position + 1; i < line->blockCount; ++i) {
+        line->blocks[i].offset--;
+    }
+    if (block->mask == 0) {
+        memmove(line->blocks + position, line->blocks + position + 1,
+                (line->blockCount - position - 1) * sizeof(SparseBlock));
+        line->blockCount--;
+    }
+    line->count--;
+    return rank;
+}
+
+/// @brief Renvoie la position dans le tableau des poids de l'arc (u, v), ou
+/// -1 s'il n'existe pas.
+INLINE int Graph_findArc(Graph *graph, int u, int v) {
+    const SparseLine *row = &graph->rows[u];
+    int position = SparseLine_findBlock(row, v >> 6);
+    if (position < 0)
+        return -1;
+    const SparseBlock *block = &row->blocks[position];
+    if (!(block->mask & (1ull << (v & 63))))
+        return -1;
+    return SparseBlock_getRank(block, v & 63);
+}
+
+void Graph_print(Graph *graph) {
+    if (!graph) {
+        printf("ERROR : Invalid graph provided\n");
+        return;
+    }
+    printf("Node count : %d\n\n", graph->size);
+    for (int i = 0; i < graph->size; ++i) {
+        printf("Node %d :", i);
+        printf(" (d+%d) ", Graph_getPositiveValency(graph, i));
+        printf(" (d-%d) ", Graph_getNegativeValency(graph, i));
+        ArcIter iter;
+        Graph_getSuccessorIterator(graph, i, &iter);
+        while (ArcIter_hasNext(&iter)) {
+            Arc *arc = ArcIter_next(&iter);
+            printf("[%f, %d, %d]", arc->weight, arc->source, arc->target);
+        }
+        printf("\n");
+    }
+}
+
+void Graph_set(Graph *graph, int u, int v, float weight) {
+    if (!graph) {
+        printf("ERROR : Invalid graph provided\n");
+        return;
+    }
+    if (u < 0 || v < 0 || u >= graph->size || v >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return;
+    }
+    SparseLine *row = &graph->rows[u];
+    int rank = Graph_findArc(graph, u, v);
+    if (weight < 0.0f) {
+        if (rank < 0)
+            return;
+        SparseLine_remove(row, v);
+        SparseLine_remove(&graph->columns[v], u);
+        memmove(row->weights + rank, row->weights + rank + 1, (row->count - rank) * sizeof(float));
+        return;
+    }
+    if (rank >= 0) {
+        row->weights[rank] = weight;
+        return;
+    }
+    if (row->count == row->weightCapacity) {
+        row->weightCapacity = row->weightCapacity ? 2 * row->weightCapacity : 4;
+        row->weights = realloc(row->weights, row->weightCapacity * sizeof(float));
+        AssertNew(row->weights);
+    }
+    rank = SparseLine_insert(row, v);
+    memmove(row->weights + rank + 1, row->weights + rank, (row->count - 1 - rank) * sizeof(float));
+    row->weights[rank] = weight;
+    SparseLine_insert(&graph->columns[v], u);
+}
+
+float Graph_get(Graph *graph, int u, int v) {
+    if (!graph)
+        printf("ERROR : Invalid graph provided\n");
+    if (u < 0 || v < 0 || u >= graph->size || v >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return -1.f;
+    }
+    int rank = Graph_findArc(graph, u, v);
+    return rank >= 0 ? graph->rows[u].weights[rank] : -1.f;
+}
+
+int Graph_getPositiveValency(Graph *graph, int u) {
+    if (!graph)
+        printf("ERROR : Invalid graph provided\n");
+    if (u < 0 || u >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return 0;
+    }
+    return graph->rows[u].count;
+}
+
+int Graph_getNegativeValency(Graph *graph, int u) {
+    if (!graph)
+        printf("ERROR : Invalid graph provided\n");
+    if (u < 0 || u >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return 0;
+    }
+    return graph->columns[u].count;
+}
+
+/// @brief Copie dans un tableau les arcs parcourus par un itérateur.
+Arc *ArcIter_toArray(ArcIter *iter, int size) {
+    if (!size)
+        return NULL;
+    Arc *arcs = calloc(size, sizeof(Arc));
+    AssertNew(arcs);
+    for (int idx = 0; ArcIter_hasNext(iter); idx++) {
+        arcs[idx] = *ArcIter_next(iter);
+    }
+    return arcs;
+}
+
+Arc *Graph_getPredecessors(Graph *graph, int u, int *size) {
+    if (!graph)
+        printf("ERROR : Invalid graph provided\n");
+    if (u < 0 || u >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return NULL;
+    }
+    *size = Graph_getNegativeValency(graph, u);
+    ArcIter iter;
+    Graph_getPredecessorIterator(graph, u, &iter);
+    return ArcIter_toArray(&iter, *size);
+}
+
+Arc *Graph_getSuccessors(Graph *graph, int u, int *size) {
+    if (!graph)
+        printf("ERROR : Invalid graph provided\n");
+    if (u < 0 || u >= graph->size) {
+        printf("ERROR : Out of bounds value\n");
+        return NULL;
+    }
+    *size = Graph_getPositiveValency(graph, u);
+    ArcIter iter;
+    Graph_getSuccessorIterator(graph, u, &iter);
+    return ArcIter_toArray(&iter, *size);
+}
+
+// L'itérateur parcourt les bits des blocs de la ligne (ou de la colonne) :
+// index vaut 64 * (position du bloc) + (bit de l'arc suivant) et end vaut
+// 64 * (nombre de blocs). Pour les successeurs, curr pointe sur le poids de
+// l'arc suivant, les poids étant rangés dans l'ordre des bits.
+
+/// @brief Renvoie la ligne (ou la colonne) parcourue par un itérateur.
+INLINE SparseLine *ArcIter_getLine(ArcIter *iter) {
+    Graph *graph = iter->graph;
+    return iter->reverse ? &graph->columns[iter->node] : &graph->rows[iter->node];
+}
+
+/// @brief Place un itérateur sur le premier bit non nul à partir du bit
+/// bit du bloc de position position.
+void ArcIter_seek(ArcIter *iter, int position, int bit) {
+    SparseLine *line = ArcIter_getLine(iter);
+    if (position < line->blockCount && bit < 64) {
+        uint64_t mask = line->blocks[position].mask & (~0ull << bit);
+        if (mask) {
+            iter->index = 64 * position + __builtin_ctzll(mask);
+            return;
+        }
+    }
+    // Les blocs stockés ne sont jamais vides.
+    position++;
+    iter->index = position < line->blockCount
+                  ? 64 * position + __builtin_ctzll(line->blocks[position].mask)
+                  : iter->end;
+}
+
+/// @brief Initialise un itérateur sur une ligne (ou une colonne).
+void ArcIter_init(Graph *graph, int u, bool reverse, ArcIter *iter) {
+    assert(graph && u >= 0 && u < graph->size);
+    iter->graph = graph;
+    iter->node = u;
+    iter->reverse = reverse;
+    SparseLine *line = ArcIter_getLine(iter);
+    iter->curr = line->weights;
+    iter->end = 64 * line->blockCount;
+    iter->index = line->blockCount > 0 ? __builtin_ctzll(line->blocks[0].mask) : iter->end;
+}
+
+void Graph_getSuccessorIterator(Graph *graph, int u, ArcIter *iter) {
+    ArcIter_init(graph, u, false, iter);
+}
+
+void Graph_getPredecessorIterator(Graph *graph, int u, ArcIter *iter) {
+    ArcIter_init(graph, u, true, iter);
+}
+
+bool ArcIter_hasNext(ArcIter *iter) {
+    return iter->index < iter->end;
+}
+
+Arc *ArcIter_next(ArcIter *iter) {
+    if (iter->index >= iter->end)
+        return NULL;
+    SparseLine *line = ArcIter_getLine(iter);
+    int position = iter->index >> 6, bit = iter->index & 63;
+    int other = 64 * line->blocks[position].index + bit;
+    if (iter->reverse) {
+        iter->arc.source = other;
+        iter->arc.target = iter->node;
+        iter->arc.weight = Graph_get(iter->graph, other, iter->node);
+    } else {
+        float *weight = iter->curr;
+        iter->arc.source = iter->node;
+        iter->arc.target = other;
+        iter->arc.weight = *weight;
+        iter->curr = weight + 1;
+    }
+    ArcIter_seek(iter, position, bit + 1);
+    return &iter->arc;
+}
+
+#endif
@@ -0,0 +1,233 @@
+#include "insee.h"
+
+/// @brief Nombre moyen de numéros par groupe de la table.
+#define INSEE_MAP_BUCKET_SIZE 4
+
+InseeCode Insee_parse(const char *str, int length)
+{
+    char code[INSEE_CODE_LENGTH];
+    if (length == INSEE_CODE_LENGTH)
+    {
+        Memcpy(code, sizeof(code), str, INSEE_CODE_LENGTH);
+    }
+    else if (length == INSEE_CODE_LENGTH - 1)
+    {
+        code[0] = '0';
+        Memcpy(code + 1, sizeof(code) - 1, str, INSEE_CODE_LENGTH - 1);
+    }
+    else
+    {
+        return INSEE_CODE_INVALID;
+    }
+
+    InseeCode value = 0;
+    for (int i = 0; i < INSEE_CODE_LENGTH; i++)
+    {
+        char c = code[i];
+        uint32_t digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (i == 1 && code[0] == '2' && (c == 'A' || c == 'B' || c == 'a' || c == 'b'))
+            digit = 10 + (toupper((unsigned char)c) - 'A');
+        else
+            return INSEE_CODE_INVALID;
+        value = 36 * value + digit;
+    }
+    return value;
+}
+
+void Insee_format(InseeCode code, char *res)
+{
+    for (int i = INSEE_CODE_LENGTH - 1; i >= 0; i--)
+    {
+        uint32_t digit = code % 36;
+        res[i] = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        code /= 36;
+    }
+    res[INSEE_CODE_LENGTH] = '\0';
+}
+
+/// @brief Couple numéro/identifiant utilisé pour construire la table.
+typedef struct sInseeEntry
+{
+    InseeCode code;
+    int32_t id;
+
+    /// @brief Position du couple dans les tableaux donnés à InseeMap_create().
+    int32_t index;
+} InseeEntry;
+
+/// @brief Compare deux couples par numéro puis par position.
+int InseeEntry_compare(const void *a, const void *b)
+{
+    const InseeEntry *entryA = (const InseeEntry *)a;
+    const InseeEntry *entryB = (const InseeEntry *)b;
+    if (entryA->code != entryB->code)
+        return entryA->code < entryB->code ? -1 : 1;
+    return (entryA->index > entryB->index) - (entryA->index < entryB->index);
+}
+
+/// @brief Tente de placer tous les numéros avec la graine courante de la
+/// table.
+/// Les groupes sont traités du plus grand au plus petit : les plus difficiles
+/// à placer le sont tant qu'il reste beaucoup de cases libres.
+/// @return true si un déplacement a été trouvé pour chaque groupe, false
+/// sinon (il faut alors changer de graine).
+bool InseeMap_build(InseeMap *map, const InseeEntry *entries)
+{
+    int count = map->count;
+    int bucketCount = map->bucketCount;
+    bool success = true;
+
+    // Répartition des numéros par groupe (tri par dénombrement).
+    int *starts = (int *)calloc(bucketCount + 1, sizeof(int));
+    InseeCode *bucketCodes = (InseeCode *)calloc(count, sizeof(InseeCode));
+    int32_t *bucketIds = (int32_t *)calloc(count, sizeof(int32_t));
+    AssertNew(starts);
+    AssertNew(bucketCodes);
+    AssertNew(bucketIds);
+    for (int i = 0; i < count; i++)
+    {
+        starts[InseeMap_reduce(InseeMap_hash(entries[i].code, map->seed), bucketCount) + 1]++;
+    }
+    int maxSize = 0;
+    for (int i = 0; i < bucketCount; i++)
+    {
+        if (starts[i + 1] > maxSize)
+            maxSize = starts[i + 1];
+        starts[i + 1] += starts[i];
+    }
+    int *fill = (int *)calloc(bucketCount, sizeof(int));
+    AssertNew(fill);
+    for (int i = 0; i < count; i++)
+    {
+        uint32_t bucket = InseeMap_reduce(InseeMap_hash(entries[i].code, map->seed), bucketCount);
+        int position = starts[bucket] + fill[bucket]++;
+        bucketCodes[position] = entries[i].code;
+        bucketIds[position] = entries[i].id;
+    }
+
+    // Ordre des groupes par taille décroissante (tri par dénombrement).
+    int *sizeStarts = (int *)calloc(maxSize + 2, sizeof(int));
+    int *order = (int *)calloc(bucketCount, sizeof(int));
+    AssertNew(sizeStarts);
+    AssertNew(order);
+    for (int i = 0; i < bucketCount; i++)
+    {
+        sizeStarts[maxSize - (starts[i + 1] - starts[i]) + 1]++;
+    }
+    for (int i = 0; i <= maxSize; i++)
+    {
+        sizeStarts[i + 1] += sizeStarts[i];
+    }
+    for (int i = 0; i < bucketCount; i++)
+    {
+        order[sizeStarts[maxSize - (starts[i + 1] - starts[i])]++] = i;
+    }
+
+    // Recherche d'un déplacement pour chaque groupe.
+    bool *taken = (bool *)calloc(count, sizeof(bool));
+    uint32_t *slots = (uint32_t *)calloc(maxSize + 1, sizeof(uint32_t));
+    AssertNew(taken);
+    AssertNew(slots);
+    long long maxTrials = 64LL * count + 1024;
+    for (int i = 0; i < bucketCount && success; i++)
+    {
+        int bucket = order[i];
+        int start = starts[bucket];
+        int size = starts[bucket + 1] - start;
+        if (size == 0)
+            break;
+
+        bool placed = false;
+        for (long long trial = 0; trial < maxTrials && !placed; trial++)
+        {
+            uint32_t displacement = InseeMap_hash((uint32_t)trial, ~map->seed);
+            int j = 0;
+            for (; j < size; j++)
+            {
+                slots[j] = InseeMap_reduce(InseeMap_hash(bucketCodes[start + j], displacement), count);
+                if (taken[slots[j]])
+                    break;
+                taken[slots[j]] = true;
+            }
+            if (j < size)
+            {
+                // Collision : on libère les cases réservées pour ce groupe.
+                while (j-- > 0)
+                    taken[slots[j]] = false;
+                continue;
+            }
+
+            map->displacements[bucket] = displacement;
+            for (j = 0; j < size; j++)
+            {
+                map->codes[slots[j]] = bucketCodes[start + j];
+                map->ids[slots[j]] = bucketIds[start + j];
+            }
+            placed = true;
+        }
+        success = placed;
+    }
+
+    free(starts);
+    free(bucketCodes);
+    free(bucketIds);
+    free(fill);
+    free(sizeStarts);
+    free(order);
+    free(taken);
+    free(slots);
+    return success;
+}
+
+InseeMap *InseeMap_create(const InseeCode *codes, const int *ids, int count)
+{
+    InseeMap *map = (InseeMap *)calloc(1, sizeof(InseeMap));
+    AssertNew(map);
+
+    // Tri des numéros et suppression des doublons (le dernier est conservé).
+    InseeEntry *entries = (InseeEntry *)calloc(count > 0 ? count : 1, sizeof(InseeEntry));
+    AssertNew(entries);
+    for (int i = 0; i < count; i++)
+    {
+        entries[i].code = codes[i];
+        entries[i].id = ids[i];
+        entries[i].index = i;
+    }
+    qsort(entries, count, sizeof(InseeEntry), InseeEntry_compare);
+    int size = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (i + 1 < count && entries[i].code == entries[i + 1].code)
+            continue;
+        entries[size++] = entries[i];
+    }
+
+    map->count = size;
+    map->bucketCount = size / INSEE_MAP_BUCKET_SIZE + 1;
+    map->displacements = (uint32_t *)calloc(map->bucketCount, sizeof(uint32_t));
+    map->codes = (InseeCode *)calloc(size > 0 ? size : 1, sizeof(InseeCode));
+    map->ids = (int32_t *)calloc(size > 0 ? size : 1, sizeof(int32_t));
+    AssertNew(map->displacements);
+    AssertNew(map->codes);
+    AssertNew(map->ids);
+
+    while (size > 0 && !InseeMap_build(map, entries))
+    {
+        map->seed++;
+    }
+    free(entries);
+
+    return map;
+}
+
+void InseeMap_destroy(InseeMap *map)
+{
+    if (!map) return;
+
+    free(map->displacements);
+    free(map->codes);
+    free(map->ids);
+    free(map);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "settings.h"
+
+/// @brief Numéro INSEE d'une commune codé sur 32 bits.
+/// Les cinq caractères du numéro (chiffres, ou lettre A/B pour la Corse :
+/// 2A004, 2B033...) sont les chiffres d'un nombre en base 36. L'ordre des
+/// codes est donc celui des numéros INSEE.
+typedef uint32_t InseeCode;
+
+/// @brief Valeur d'un numéro INSEE invalide.
+#define INSEE_CODE_INVALID UINT32_MAX
+
+/// @brief Nombre de caractères d'un numéro INSEE.
+#define INSEE_CODE_LENGTH 5
+
+/// @brief Lit un numéro INSEE.
+/// Un numéro de quatre caractères est complété par un '0' initial (les
+/// fichiers perdent parfois le zéro des départements 01 à 09).
+/// Les lettres de la Corse peuvent être en minuscules.
+/// @param str la chaîne de caractères (pas nécessairement terminée par '\0').
+/// @param length le nombre de caractères à lire.
+/// @return Le numéro codé ou INSEE_CODE_INVALID si la chaîne n'est pas un
+/// numéro INSEE.
+InseeCode Insee_parse(const char *str, int length);
+
+/// @brief Écrit un numéro INSEE sous sa forme textuelle.
+/// @param code le numéro codé (valide).
+/// @param res le tableau dans lequel écrire les INSEE_CODE_LENGTH caractères
+/// suivis de '\0'.
+void Insee_format(InseeCode code, char *res);
+
+/// @brief Structure représentant une table associant un identifiant de
+/// commune à chaque numéro INSEE.
+/// Il s'agit d'une fonction de hachage parfaite minimale construite selon
+/// la méthode CHD (« hash and displace ») : les numéros sont répartis dans
+/// des groupes, puis on cherche pour chaque groupe un déplacement envoyant
+/// tous ses numéros dans des cases libres. Chacune des count cases contient
+/// exactement un numéro.
+/// La table n'est plus modifiée après sa construction.
+typedef struct sInseeMap
+{
+    /// @brief Nombre de numéros (et de cases).
+    int count;
+
+    /// @brief Nombre de groupes.
+    int bucketCount;
+
+    /// @brief Graine de la fonction de hachage des groupes.
+    uint32_t seed;
+
+    /// @brief Déplacement de chaque groupe.
+    uint32_t *displacements;
+
+    /// @brief Numéro stocké dans chaque case.
+    InseeCode *codes;
+
+    /// @brief Identifiant associé à chaque case.
+    int32_t *ids;
+} InseeMap;
+
+/// @brief Crée la table associant des identifiants à des numéros INSEE.
+/// Si un numéro apparaît plusieurs fois, le dernier identifiant est conservé.
+/// @param codes les numéros (valides).
+/// @param ids les identifiants associés aux numéros.
+/// @param count le nombre de numéros.
+/// @return La table créée.
+InseeMap *InseeMap_create(const InseeCode *codes, const int *ids, int count);
+
+/// @brief Détruit une table créée avec InseeMap_create().
+/// @param map la table.
+void InseeMap_destroy(InseeMap *map);
+
+/// @brief Mélange les bits d'un entier (finaliseur de MurmurHash3).
+INLINE uint32_t InseeMap_hash(uint32_t value, uint32_t seed)
+{
+    value ^= seed;
+    value ^= value >> 16;
+    value *= 0x85EBCA6Bu;
+    value ^= value >> 13;
+    value *= 0xC2B2AE35u;
+    value ^= value >> 16;
+    return value;
+}
+
+/// @brief Ramène une valeur de hachage dans l'intervalle [0, range[ sans
+/// division.
+INLINE uint32_t InseeMap_reduce(uint32_t hash, int range)
+{
+    return (uint32_t)(((uint64_t)hash * (uint32_t)range) >> 32);
+}
+
+/// @brief Renvoie l'identifiant associé à un numéro INSEE.
+/// Cette méthode s'exécute en O(1) : deux calculs de hachage et une
+/// comparaison.
+/// @param map la table.
+/// @param code le numéro recherché.
+/// @return L'identifiant associé au numéro ou -1 s'il n'est pas dans la table.
+INLINE int InseeMap_get(const InseeMap *map, InseeCode code)
+{
+    if (map->count <= 0)
+        return -1;
+
+    uint32_t bucket = InseeMap_reduce(InseeMap_hash(code, map->seed), map->bucketCount);
+    uint32_t slot = InseeMap_reduce(InseeMap_hash(code, map->displacements[bucket]), map->count);
+    return map->codes[slot] == code ? map->ids[slot] : -1;
+}
@@ -0,0 +1,155 @@
+#include "settings.h"
+#include "intHeap.h"
+
+IntHeap *IntHeap_create(int capacity)
+{
+    IntHeap *heap = (IntHeap *)calloc(1, sizeof(IntHeap));
+    AssertNew(heap);
+
+    heap->values = (int *)calloc(capacity, sizeof(int));
+    AssertNew(heap->values);
+    heap->keys = (float *)calloc(capacity, sizeof(float));
+    AssertNew(heap->keys);
+    heap->positions = (int *)calloc(capacity, sizeof(int));
+    AssertNew(heap->positions);
+
+    for (int i = 0; i < capacity; i++)
+    {
+        heap->positions[i] = -1;
+    }
+    heap->size = 0;
+    heap->capacity = capacity;
+
+    return heap;
+}
+
+void IntHeap_destroy(IntHeap *heap)
+{
+    if (!heap) return;
+
+    free(heap->values);
+    free(heap->keys);
+    free(heap->positions);
+    free(heap);
+}
+
+bool IntHeap_isEmpty(IntHeap *heap)
+{
+    return heap->size <= 0;
+}
+
+bool IntHeap_contains(IntHeap *heap, int value)
+{
+    assert(value >= 0 && value < heap->capacity);
+    return heap->positions[value] >= 0;
+}
+
+/// @brief Place un élément à une position du tas et met à jour son index.
+INLINE void IntHeap_place(IntHeap *heap, int index, int value)
+{
+    heap->values[index] = value;
+    heap->positions[value] = index;
+}
+
+/// @brief Fait remonter un élément jusqu'à ce que la propriété de tas soit
+/// respectée.
+void IntHeap_siftUp(IntHeap *heap, int index)
+{
+    int value = heap->values[index];
+    float key = heap->keys[value];
+
+    while (index > 0)
+    {
+        int parent = (index - 1) / 2;
+        int parentValue = heap->values[parent];
+        if (heap->keys[parentValue] <= key)
+            break;
+
+        IntHeap_place(heap, index, parentValue);
+        index = parent;
+    }
+    IntHeap_place(heap, index, value);
+}
+
+/// @brief Fait descendre un élément jusqu'à ce que la propriété de tas soit
+/// respectée.
+void IntHeap_siftDown(IntHeap *heap, int index)
+{
+    int value = heap->values[index];
+    float key = heap->keys[value];
+    int size = heap->size;
+
+    while (true)
+    {
+        int child = 2 * index + 1;
+        if (child >= size)
+            break;
+
+        // On choisit le fils de plus petite priorité
+        if (child + 1 < size &&
+            heap->keys[heap->values[child + 1]] < heap->keys[heap->values[child]])
+        {
+            child++;
+        }
+        int childValue = heap->values[child];
+        if (heap->keys[childValue] >= key)
+            break;
+
+        IntHeap_place(heap, index, childValue);
+        index = child;
+    }
+    IntHeap_place(heap, index, value);
+}
+
+void IntHeap_push(IntHeap *heap, int value, float key)
+{
+    assert(value >= 0 && value < heap->capacity);
+
+    int index = heap->positions[value];
+    if (index >= 0)
+    {
+        // L'élément est déjà présent, on diminue éventuellement sa priorité
+        if (key >= heap->keys[value])
+            return;
+
+        heap->keys[value] = key;
+        IntHeap_siftUp(heap, index);
+        return;
+    }
+
+    heap->keys[value] = key;
+    index = heap->size++;
+    IntHeap_place(heap, index, value);
+    IntHeap_siftUp(heap, index);
+}
+
+int IntHeap_popMin(IntHeap *heap)
+{
+    if (heap->size <= 0)
+    {
+        assert(false);
+        return -1;
+    }
+
+    int min = heap->values[0];
+    heap->positions[min] = -1;
+    heap->size--;
+
+    if (heap->size > 0)
+    {
+        // Le dernier élément prend la place de la racine puis redescend
+        IntHeap_place(heap, 0, heap->values[heap->size]);
+        IntHeap_siftDown(heap, 0);
+    }
+
+    return min;
+}
+
+void IntHeap_clear(IntHeap *heap)
+{
+    for (int i = 0; i < heap->size; i++)
+    {
+        heap->positions[heap->values[i]] = -1;
+    }
+    heap->size = 0;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "settings.h"
+
+typedef struct sIntHeap IntHeap;
+
+/// @brief Structure représentant un tas binaire minimum indexé.
+/// Les éléments sont des entiers compris entre 0 et la capacité du tas moins 1
+/// (typiquement des identifiants de noeuds) et chacun est associé à une
+/// priorité. La position de chaque élément dans le tas est mémorisée, ce qui
+/// permet de diminuer sa priorité en temps logarithmique.
+struct sIntHeap
+{
+    /// @brief Tableau des éléments, organisé en tas.
+    int *values;
+
+    /// @brief Priorité de chaque élément, indexée par l'élément.
+    float *keys;
+
+    /// @brief Position de chaque élément dans le tableau values.
+    /// Vaut -1 si l'élément n'est pas dans le tas.
+    int *positions;
+
+    /// @brief Nombre d'éléments présents dans le tas.
+    int size;
+
+    /// @brief Nombre maximal d'éléments du tas.
+    int capacity;
+};
+
+/// @brief Crée un tas vide.
+/// @param capacity le nombre maximal d'éléments. Les éléments insérés doivent
+/// être compris entre 0 et capacity - 1.
+/// @return Le tas créé.
+IntHeap *IntHeap_create(int capacity);
+
+/// @brief Détruit un tas créé avec IntHeap_create().
+/// @param heap le tas.
+void IntHeap_destroy(IntHeap *heap);
+
+/// @brief Indique si un tas est vide.
+/// @param heap le tas.
+/// @return true si le tas est vide, false sinon.
+bool IntHeap_isEmpty(IntHeap *heap);
+
+/// @brief Indique si un élément est présent dans un tas.
+/// @param heap le tas.
+/// @param value l'élément.
+/// @return true si l'élément est dans le tas, false sinon.
+bool IntHeap_contains(IntHeap *heap, int value);
+
+/// @brief Insère un élément dans un tas ou diminue sa priorité s'il est déjà
+/// présent.
+/// Si l'élément est présent avec une priorité inférieure ou égale, le tas
+/// n'est pas modifié.
+/// Cette méthode s'exécute en O(log n).
+/// @param heap le tas.
+/// @param value l'élément.
+/// @param key la priorité de l'élément.
+void IntHeap_push(IntHeap *heap, int value, float key);
+
+/// @brief Supprime et renvoie l'élément de plus petite priorité d'un tas.
+/// L'utilisateur doit au préalable vérifier que le tas est non vide.
+/// Cette méthode s'exécute en O(log n).
+/// @param heap le tas.
+/// @return L'élément de plus petite priorité.
+int IntHeap_popMin(IntHeap *heap);
+
+/// @brief Vide un tas sans libérer sa mémoire.
+/// Cette méthode s'exécute en temps proportionnel au nombre d'éléments
+/// présents.
+/// @param heap le tas.
+void IntHeap_clear(IntHeap *heap);
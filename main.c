@@ -3,7 +3,20 @@
 #include "uniStr.h"
 #include "cJSON.h"
 #include "dict.h"
+#include "frozenDict.h"
+#include "insee.h"
+#include "uniStrView.h"
 #include "poi.h"
+#include "snapshot.h"
+#include "csv.h"
+#include "arena.h"
+#include "nameIndex.h"
+#include "nodeOrder.h"
+
+#include <pthread.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 /// @brief Print le message correspondant à l'ouverture du fichier.
 /// @param err 1 si l'ouverture à échoué,
@@ -22,6 +35,13 @@ INLINE void err_open(bool err, char *path) {
     }
 }
 
+/// @brief Lit une ligne saisie par l'utilisateur (les espaces sont conservés).
+/// @param input Le buffer de 1024 caractères où écrire la ligne.
+/// @return true si une ligne a été lue, false en fin de fichier.
+INLINE bool inputRead(char *input) {
+    return scanf(" %1023[^\n]", input) == 1;
+}
+
 /// @brief Print le message correspondant au parsing du fichier.
 /// @param err 1 si le parsing à échoué,
 /// 0 sinon.
@@ -40,62 +60,64 @@ INLINE void err_parse(bool err, char *path) {
 }
 
 
+/// @brief Copie un champ csv dans une arène.
+/// @param field Le champ.
+/// @param arena L'arène.
+/// @return La copie du champ terminée par '\0'.
+INLINE char *fieldCopy(const CsvField *field, Arena *arena) {
+    char *string = Arena_alloc(arena, field->length + 1);
+    CsvField_copyTo(field, string, field->length + 1);
+    return string;
+}
+
+
 /// @brief Parse le fichier des communes.
-/// @param input Le fichier csv des communes.
-/// @param sep Le séparateur.
+/// @param input Le lecteur du fichier csv des communes.
+/// @param arena L'arène dans laquelle allouer les communes.
 /// @param count Le nombre total de communes.
 /// @return Retourne un dictionnaire INSEE - Structure commune, si le parsing à fonctionné,
 /// NULL sinon.
 /// @author Arthur
-Dict *municipalitiesParse(FILE *input, UniStr *sep, int *count) {
+FrozenDict *municipalitiesParse(CsvReader *input, Arena *arena, int *count) {
     *count = -1;
-    int subCount = 0, end = 0;
-    char *string = calloc(MAX_MUNICIPALITIES, sizeof(char));
-
-    // On crée un dictionnaire.
-    Dict *dict = Dict_create();
+    CsvField fields[7];
+    int fieldCount;
+    KVPair *pairs = NULL;
+    int pairCount = 0, pairCapacity = 0;
 
     // Tant qu'il y a des lignes dans le fichier :
-    while (fgets(string, sizeof(char) * MAX_MUNICIPALITIES, input)) {
-        char cat[6];
-        cat[0] = '\0';
-        // On décode la ligne.
-        UniStr *decoded = UniStr_decodeU8(string, sizeof(string) * MAX_MUNICIPALITIES);
-        // On divise la ligne en chaines de caractères selon le séparateur.
-        UniStr **subs = UniStr_split(decoded, sep, &subCount);
-        // On crée une structure commune et on la remplie.
-        Municipalities *municipality = calloc(1, sizeof(Municipalities));
-        municipality->id = *count;
-        char *len = UniStr_encodeU8(subs[0]);
-        municipality->code_commune_INSEE = calloc(6, sizeof(char));
-        municipality->nom_commune_postal = calloc(1024, sizeof(char));
-        if (strlen(len) == 4) {
-            strcat(cat, "0");
-            strcat(cat, len);
-            strcpy(municipality->code_commune_INSEE, cat);
-        } else {
-            char *cci = UniStr_encodeU8(subs[0]);
-            strcpy(municipality->code_commune_INSEE, cci);
-            free(cci);
+    while ((fieldCount = CsvReader_nextRow(input, fields, 7)) >= 0) {
+        // Si la ligne nous intéresse :
+        if (*count > -1 && fieldCount >= 7) {
+            // On crée une structure commune et on la remplie.
+            Municipalities *municipality = Arena_alloc(arena, sizeof(Municipalities));
+            municipality->id = *count;
+            municipality->code_commune_INSEE = Arena_alloc(arena, INSEE_CODE_LENGTH + 1);
+            // Le numéro INSEE est remis au bon format (zéro initial manquant) s'il est valide :
+            InseeCode code = Insee_parse(fields[0].data, fields[0].length);
+            if (code != INSEE_CODE_INVALID) {
+                Insee_format(code, municipality->code_commune_INSEE);
+            } else {
+                CsvField_copyTo(&fields[0], municipality->code_commune_INSEE, INSEE_CODE_LENGTH + 1);
+            }
+            municipality->nom_commune_postal = fieldCopy(&fields[1], arena);
+            municipality->latitude = CsvField_getDouble(&fields[5]);
+            municipality->longitude = CsvField_getDouble(&fields[6]);
+            // On associe la commune à son numéro INSEE :
+            if (pairCount == pairCapacity) {
+                pairCapacity = pairCapacity ? 2 * pairCapacity : 1024;
+                pairs = realloc(pairs, pairCapacity * sizeof(KVPair));
+                AssertNew(pairs);
+            }
+            pairs[pairCount].key = municipality->code_commune_INSEE;
+            pairs[pairCount].value = municipality;
+            pairCount++;
         }
-        free(len);
-        char * ncp = UniStr_encodeU8(subs[1]);
-        strcpy(municipality->nom_commune_postal, ncp);
-        free(ncp);
-        municipality->latitude = UniStr_getDouble(subs[5], 0, &end);
-        municipality->longitude = UniStr_getDouble(subs[6], 0, &end);
-        if (*count > -1)
-            // Si la ligne nous intéresse, on ajoute la commune au dictionnaire et on l'associe à son numéro INSEE :
-            Dict_insert(dict, municipality->code_commune_INSEE, municipality);
-        else
-            // Sinon, on détruit la commune :
-            free(municipality);
         (*count)++;
-
-        UniStr_destroyArray(subs, subCount);
-        UniStr_destroy(decoded);
     }
-    free(string);
+    // On crée le dictionnaire en une seule fois (le fichier est trié par numéro INSEE).
+    FrozenDict *dict = FrozenDict_createFromArray(pairs, pairCount);
+    free(pairs);
     // Si le dictionnaire existe, on le retourne :
     if (dict)
         return dict;
@@ -104,62 +126,115 @@ Dict *municipalitiesParse(FILE *input, UniStr *sep, int *count) {
 }
 
 
-/// @brief Parse le fichier des communes adjacentes.
-/// @param input Le fichier csv des communes adjacentes.
-/// @param sep Le séparateur.
+/// @brief Renumérote les communes le long d'une courbe de Hilbert.
+/// Les ID sont d'abord attribués dans l'ordre du fichier : les communes voisines
+/// ont alors des ID éloignés et les tableaux indexés par ID de l'algorithme de
+/// Dijkstra sont parcourus avec beaucoup de défauts de cache. Après la
+/// renumérotation, les communes proches ont des ID proches.
+/// Cette fonction doit être appelée avant la création de la table des numéros
+/// INSEE et du graph, qui utilisent ainsi directement les nouveaux ID.
+/// @param dict Le dictionnaire des communes.
 /// @param count Le nombre total de communes.
+void municipalitiesReorder(FrozenDict *dict, int count) {
+    double *latitudes = calloc(count > 0 ? count : 1, sizeof(double));
+    double *longitudes = calloc(count > 0 ? count : 1, sizeof(double));
+    AssertNew(latitudes);
+    AssertNew(longitudes);
+    // Les ID sans commune et les communes sans coordonnées sont placés à la fin.
+    for (int i = 0; i < count; i++) {
+        latitudes[i] = NAN;
+        longitudes[i] = NAN;
+    }
+    FrozenDictIter iter;
+    FrozenDict_getIterator(dict, &iter);
+    while (FrozenDictIter_hasNext(&iter)) {
+        Municipalities *municipality = FrozenDictIter_next(&iter)->value;
+        if (municipality->latitude != 0 || municipality->longitude != 0) {
+            latitudes[municipality->id] = municipality->latitude;
+            longitudes[municipality->id] = municipality->longitude;
+        }
+    }
+
+    // On remplace l'ID de chaque commune par sa position sur la courbe.
+    NodeOrder *order = NodeOrder_createHilbert(latitudes, longitudes, count);
+    FrozenDict_getIterator(dict, &iter);
+    while (FrozenDictIter_hasNext(&iter)) {
+        Municipalities *municipality = FrozenDictIter_next(&iter)->value;
+        municipality->id = order->newIds[municipality->id];
+    }
+    NodeOrder_destroy(order);
+    free(latitudes);
+    free(longitudes);
+}
+
+
+/// @brief Crée la table associant à chaque numéro INSEE l'ID de sa commune.
 /// @param dict Le dictionnaire des communes.
+/// @return Retourne la table créée.
+InseeMap *inseeMapCreate(FrozenDict *dict) {
+    int count = FrozenDict_size(dict);
+    InseeCode *codes = calloc(count > 0 ? count : 1, sizeof(InseeCode));
+    int *ids = calloc(count > 0 ? count : 1, sizeof(int));
+    AssertNew(codes);
+    AssertNew(ids);
+    int size = 0;
+    FrozenDictIter iter;
+    FrozenDict_getIterator(dict, &iter);
+    while (FrozenDictIter_hasNext(&iter)) {
+        const KVPair *pair = FrozenDictIter_next(&iter);
+        Municipalities *municipality = pair->value;
+        InseeCode code = Insee_parse(pair->key, (int) strlen(pair->key));
+        if (code == INSEE_CODE_INVALID)
+            continue;
+        codes[size] = code;
+        ids[size] = municipality->id;
+        size++;
+    }
+    InseeMap *map = InseeMap_create(codes, ids, size);
+    free(codes);
+    free(ids);
+    return map;
+}
+
+
+/// @brief Parse le fichier des communes adjacentes.
+/// Les numéros INSEE sont lus directement dans le fichier, sans copie, et
+/// résolus avec la table des numéros : le fichier est parcouru une seule fois.
+/// @param input Le lecteur du fichier csv des communes adjacentes.
+/// @param count Le nombre total de communes.
+/// @param map La table Numéro INSEE - ID.
 /// @return Retourne un graph des Communes - Communes adjacentes, si le parsing à fonctionné,
 /// NULL Sinon.
 /// @author Arthur
-Graph *adjMunicipalitiesParse(FILE *input, UniStr *sep, int count, Dict *dict) {
-    int subCount = 0, childCount = 0, cnt = -1, source, target;
-    char *string = calloc(MAX_MUNICIPALITIES, sizeof(char));
+Graph *adjMunicipalitiesParse(CsvReader *input, int count, InseeMap *map) {
+    int cnt = -1, source, target, fieldCount;
+    CsvField fields[4];
+    UniStrView separator = UniStrView_make("|", 1);
 
     // On crée un graphe.
     Graph *graph = Graph_create(count);
 
     // Tant qu'il y a des lignes dans le fichier :
-    while (fgets(string, sizeof(char) * MAX_MUNICIPALITIES, input)) {
-
-        // On décode la ligne.
-        UniStr *decoded = UniStr_decodeU8(string, sizeof(string) * MAX_MUNICIPALITIES);
-        // On divise la ligne en chaines des caractères selon le séparateur.
-        UniStr **subs = UniStr_split(decoded, sep, &subCount);
-
-        UniStr *pipeSeparator = UniStr_decodeU8("|", -1);
-
+    while ((fieldCount = CsvReader_nextRow(input, fields, 4)) >= 0) {
         // Si la ligne nous intéresse :
-        if (cnt > -1) {
+        if (cnt > -1 && fieldCount >= 4) {
             // On récupère la commune source.
-            char *key = UniStr_encodeU8(subs[0]);
-            Municipalities *sourceMunicipality = Dict_get(dict, key);
-            if (sourceMunicipality) {
-                source = sourceMunicipality->id;
-                // On divise la chaine de caractères en numéros INSEE selon le séparateur.
-                UniStr **children = UniStr_split(subs[3], pipeSeparator, &childCount);
-                // Pour chaque numéro INSEE :
-                for (int i = 0; i < childCount; ++i) {
+            source = InseeMap_get(map, Insee_parse(fields[0].data, fields[0].length));
+            if (source >= 0) {
+                // On parcourt les numéros INSEE séparés par des '|' :
+                UniStrView children = CsvField_getView(&fields[3]), child;
+                while (UniStrView_splitNext(&children, separator, &child)) {
                     // On récupère la commune associée au numéro INSEE.
-                    char *keyChild = UniStr_encodeU8(children[i]);
-                    Municipalities *targetMunicipality = Dict_get(dict, keyChild);
-                    if (targetMunicipality) {
-                        target = targetMunicipality->id;
+                    target = InseeMap_get(map, Insee_parse(child.data, child.length));
+                    if (target >= 0) {
                         // On crée l'arc entre la commune source et la commune destination
                         Graph_set(graph, source, target, 0);
                     }
-                    free(keyChild);
                 }
-                UniStr_destroyArray(children, childCount);
             }
-            free(key);
         }
         cnt++;
-        UniStr_destroyArray(subs, subCount);
-        UniStr_destroy(decoded);
-        UniStr_destroy(pipeSeparator);
     }
-    free(string);
 
     // Si le graph existe, on le retourne :
     if (graph)
@@ -169,45 +244,157 @@ Graph *adjMunicipalitiesParse(FILE *input, UniStr *sep, int count, Dict *dict) {
 }
 
 
+/// @brief Structure représentant un morceau du fichier des POI et les POI
+/// qu'il contient.
+typedef struct sPoiChunk {
+    /// @brief Lecteur limité au morceau.
+    CsvReader reader;
+
+    /// @brief POI retenus, dans l'ordre du fichier.
+    Poi **pois;
+
+    /// @brief Nombre de POI retenus.
+    int count;
+
+    /// @brief Capacité du tableau pois.
+    int capacity;
+
+    /// @brief Arène dans laquelle sont alloués les POI du morceau.
+    Arena *arena;
+} PoiChunk;
+
+/// @brief Renvoie le nombre de threads à utiliser pour parser une zone.
+/// Chaque thread traite au moins MIN_PARSE_CHUNK_SIZE octets.
+/// @param size La taille de la zone en octets.
+/// @return Le nombre de threads, entre 1 et MAX_PARSE_THREADS.
+int parseThreadCount(size_t size) {
+    long cpuCount = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+    cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    long threadCount = (long) (size / MIN_PARSE_CHUNK_SIZE);
+    if (threadCount > cpuCount)
+        threadCount = cpuCount;
+    if (threadCount > MAX_PARSE_THREADS)
+        threadCount = MAX_PARSE_THREADS;
+    return threadCount < 1 ? 1 : (int) threadCount;
+}
+
+/// @brief Indique si la valeur de la colonne amenity d'un POI correspond à un bar.
+/// @param amenity Le champ amenity.
+/// @return true si le POI est un bar, un pub ou un café, false sinon.
+INLINE bool poiIsBar(const CsvField *amenity) {
+    return CsvField_equals(amenity, "bar") || CsvField_equals(amenity, "pub") ||
+           CsvField_equals(amenity, "cafe");
+}
+
+/// @brief Parse un morceau du fichier des POI en ne gardant que les bars.
+/// @param arg Le morceau (PoiChunk).
+/// @return NULL.
+/// @author Arthur
+void *poiParseChunk(void *arg) {
+    PoiChunk *chunk = arg;
+    CsvField fields[18];
+    int fieldCount;
+
+    // Tant qu'il y a des lignes dans le morceau :
+    while (true) {
+        // On écarte d'abord la ligne sur les octets de la colonne amenity,
+        // sans découper les autres champs.
+        CsvField amenity;
+        if (CsvReader_peekField(&chunk->reader, 17, &amenity) && !poiIsBar(&amenity)) {
+            CsvReader_skipRow(&chunk->reader);
+            continue;
+        }
+
+        if ((fieldCount = CsvReader_nextRow(&chunk->reader, fields, 18)) < 0)
+            break;
+        if (fieldCount < 18)
+            continue;
+        // Si le POI nous intéresse :
+        if (poiIsBar(&fields[17])) {
+            // On crée une structure POI et on la remplie.
+            Poi *poi = Arena_alloc(chunk->arena, sizeof(Poi));
+            poi->name = fieldCopy(&fields[4], chunk->arena);
+            poi->longitude = CsvField_getDouble(&fields[1]);
+            poi->latitude = CsvField_getDouble(&fields[2]);
+            if (chunk->count == chunk->capacity) {
+                chunk->capacity = chunk->capacity ? 2 * chunk->capacity : 64;
+                chunk->pois = realloc(chunk->pois, chunk->capacity * sizeof(Poi *));
+                AssertNew(chunk->pois);
+            }
+            chunk->pois[chunk->count++] = poi;
+        }
+    }
+    return NULL;
+}
+
 /// @brief Parse le fichier des POI.
-/// @param input Le fichier csv des poi.
-/// @param sep Le séparateur.
+/// Le fichier est découpé en morceaux parsés en parallèle, puis les POI sont
+/// ajoutés au dictionnaire dans l'ordre du fichier : le résultat est le même
+/// qu'avec un seul thread.
+/// @param input Le lecteur du fichier csv des poi.
+/// @param arena L'arène dans laquelle allouer les POI.
 /// @param count Le nombre total de poi.
 /// @return Retourne un dictionnaire des poi, si le parsing à fonctionné,
 /// NULL Sinon.
 /// @author Arthur
-Dict *poiParse(FILE *input, UniStr *sep, int *count) {
+FrozenDict *poiParse(CsvReader *input, Arena *arena, int *count) {
     *count = -1;
-    int subCount = 0, end = 0;
-    char *string = calloc(MAX_MUNICIPALITIES, sizeof(char));
-
-    // On crée un dictionnaire.
-    Dict *dict = Dict_create();
 
-    // Tant qu'il y a des lignes dans le fichier :
-    while (fgets(string, sizeof(char) * MAX_MUNICIPALITIES, input)) {
-        // On décode la ligne.
-        UniStr *decoded = UniStr_decodeU8(string, sizeof(string) * MAX_MUNICIPALITIES);
-        // On divise la ligne en chaines de caractères selon le séparateur.
-        UniStr **subs = UniStr_split(decoded, sep, &subCount);
+    // On découpe le fichier en morceaux commençant au début d'une ligne.
+    int chunkCount = parseThreadCount(input->end - input->curr);
+    PoiChunk *chunks = calloc(chunkCount, sizeof(PoiChunk));
+    pthread_t *threads = calloc(chunkCount, sizeof(pthread_t));
+    bool *started = calloc(chunkCount, sizeof(bool));
+    CsvReader *readers = calloc(chunkCount, sizeof(CsvReader));
+    AssertNew(chunks);
+    AssertNew(threads);
+    AssertNew(started);
+    AssertNew(readers);
+    CsvReader_split(input, readers, chunkCount);
+    for (int i = 0; i < chunkCount; i++) {
+        chunks[i].reader = readers[i];
+        chunks[i].arena = Arena_create(0);
+    }
+    input->curr = input->end;
+
+    // Le premier morceau est traité par le thread courant.
+    for (int i = 1; i < chunkCount; i++)
+        started[i] = pthread_create(&threads[i], NULL, poiParseChunk, &chunks[i]) == 0;
+    poiParseChunk(&chunks[0]);
+    for (int i = 1; i < chunkCount; i++) {
+        if (started[i])
+            pthread_join(threads[i], NULL);
+        else
+            poiParseChunk(&chunks[i]);
+    }
 
-        // Si le POI nous intéresse :
-        char *amenity = UniStr_encodeU8(subs[17]);
-        if (!strcmp(amenity, "bar") || !strcmp(amenity, "pub") ||
-            !strcmp(amenity, "cafe")) {
-            // On crée une structure POI et on la remplie.
-            Poi *poi = calloc(1, sizeof(Poi));
-            poi->name = UniStr_encodeU8(subs[4]);
-            poi->longitude = UniStr_getDouble(subs[1], 0, &end);
-            poi->latitude = UniStr_getDouble(subs[2], 0, &end);
-            Dict_insert(dict, poi->name, poi);
+    // On rassemble les POI dans l'ordre du fichier puis on crée le dictionnaire.
+    int poiCount = 0;
+    for (int i = 0; i < chunkCount; i++)
+        poiCount += chunks[i].count;
+    KVPair *pairs = calloc(poiCount > 0 ? poiCount : 1, sizeof(KVPair));
+    AssertNew(pairs);
+    KVPair *pair = pairs;
+    for (int i = 0; i < chunkCount; i++) {
+        for (int j = 0; j < chunks[i].count; j++) {
+            Poi *poi = chunks[i].pois[j];
+            pair->key = poi->name;
+            pair->value = poi;
+            pair++;
             (*count)++;
         }
-        free(amenity);
-        UniStr_destroyArray(subs, subCount);
-        UniStr_destroy(decoded);
+        free(chunks[i].pois);
+        Arena_merge(arena, chunks[i].arena);
+        Arena_destroy(chunks[i].arena);
     }
-    free(string);
+    FrozenDict *dict = FrozenDict_createFromArray(pairs, poiCount);
+    free(pairs);
+    free(readers);
+    free(started);
+    free(threads);
+    free(chunks);
 
     // Si le dictionnaire existe, on le retourne :
     if (dict)
@@ -222,13 +409,13 @@ Dict *poiParse(FILE *input, UniStr *sep, int *count) {
 /// @param dict Le dictionnaire des communes.
 /// @return Retourne un tableau ID - Commune.
 /// @author Arthur
-Municipalities **linkIdToStruct(int count, Dict *dict) {
+Municipalities **linkIdToStruct(int count, FrozenDict *dict) {
     Municipalities **municipalities = calloc(count, sizeof(Municipalities));
-    DictIter *iter = calloc(1, sizeof(DictIter));
-    Dict_getIterator(dict, iter);
+    FrozenDictIter *iter = calloc(1, sizeof(FrozenDictIter));
+    FrozenDict_getIterator(dict, iter);
     // Tant qu'il y a des communes dans le dictionnaire :
-    while (DictIter_hasNext(iter)) {
-        KVPair *pair = DictIter_next(iter);
+    while (FrozenDictIter_hasNext(iter)) {
+        const KVPair *pair = FrozenDictIter_next(iter);
         if (!pair) continue;
         Municipalities *value = pair->value;
         // On les ajoute dans le tableau.
@@ -242,56 +429,59 @@ Municipalities **linkIdToStruct(int count, Dict *dict) {
 }
 
 
+/// @brief Affiche les communes dont le nom ressemble le plus à une saisie.
+/// @param index L'index des noms des communes.
+/// @param input La saisie.
+void suggestionsPrint(NameIndex *index, char *input) {
+    int positions[5];
+    int count = NameIndex_search(index, input, positions, 5);
+    if (count <= 0)
+        return;
+
+    printf("\033[0;33m");
+    printf("Did you mean:\n");
+    for (int i = 0; i < count; i++) {
+        Municipalities *municipality = NameIndex_getMunicipality(index, positions[i]);
+        printf("  %s %s\n", municipality->code_commune_INSEE, municipality->nom_commune_postal);
+    }
+    printf("\033[0m");
+}
+
+
 /// @brief Cherche la commune à partir de son numéro INSEE ou de son nom.
-/// La fonction n'est pas sensible à la casse.
-/// @param dict Le dictionnaire des communes.
+/// La fonction n'est pas sensible à la casse. Si plusieurs communes portent
+/// le nom recherché, elles sont affichées et celle de plus petit numéro INSEE
+/// est renvoyée.
+/// @param map La table Numéro INSEE - ID.
+/// @param municipalities Le tableau ID - Commune.
+/// @param index L'index des noms des communes.
 /// @param input La chaine de caractères à trouver.
 /// @return Renvoie la structure si elle est trouvé,
 /// NULL sinon.
 /// @author Arthur
-Municipalities *getMunicipality(Dict *dict, char *input) {
-    // Si l'entrée correspond à un numéro INSEE :
-    if (isdigit(input[0])) {
-        // Si le numéro INSEE n'est pas au bon format, on le reformate correctement :
-        if (strlen(input) == 4) {
-            char cat[6];
-            cat[0] = '\0';
-            strcat(cat, "0");
-            strcat(cat, input);
-            input = cat;
-        }
-        // On cherche le numéro INSEE dans le dictionnaire et on retourne la commune correspondante.
-        return Dict_get(dict, input);
-        // Sinon, on parcourt le dictionnaire à la recherche du nom de la commune :
+Municipalities *getMunicipality(InseeMap *map, Municipalities **municipalities, NameIndex *index, char *input) {
+    UniStrView view = UniStrView_trim(UniStrView_make(input, -1));
+    // Si l'entrée correspond à un numéro INSEE (éventuellement sans son zéro initial) :
+    if (view.length > 0 && isdigit((unsigned char) view.data[0])) {
+        // On cherche le numéro INSEE dans la table et on retourne la commune correspondante.
+        int id = InseeMap_get(map, Insee_parse(view.data, view.length));
+        return id >= 0 ? municipalities[id] : NULL;
+        // Sinon, on cherche le nom de la commune dans l'index :
     } else {
-        DictIter *iter = calloc(1, sizeof(DictIter));
-        Dict_getIterator(dict, iter);
-        while (DictIter_hasNext(iter)) {
-            KVPair *pair = DictIter_next(iter);
-            if (!pair)
-                continue;
-            Municipalities *value = pair->value;
-            if (value) {
-                // On Reformate la chaine de caractère entrée pour la faire correspondre à celles dans le dictionnaire.
-                UniStr *decoded = UniStr_decodeU8(input, -1);
-                char *caseSensitive = UniStr_encodeAscii(decoded);
-                for (int i = 0; i < strlen(caseSensitive); i++) {
-                    caseSensitive[i] = toupper((unsigned char) caseSensitive[i]);
-                    if (caseSensitive[i] == '-')
-                        caseSensitive[i] = ' ';
-                }
-                if (!strcmp(value->nom_commune_postal, caseSensitive)) {
-                    UniStr_destroy(decoded);
-                    free(caseSensitive);
-                    free(iter);
-                    // On retourne la commune correspondante.
-                    return value;
-                }
-                UniStr_destroy(decoded);
-                free(caseSensitive);
-            }
+        int count = 0;
+        int first = NameIndex_find(index, input, &count);
+        if (count > 1) {
+            // On affiche les homonymes.
+            printf("\033[0;33m");
+            printf("WARNING: %d municipalities are named %s:", count, NameIndex_getName(index, first));
+            for (int i = first; i < first + count; i++)
+                printf(" %s", NameIndex_getMunicipality(index, i)->code_commune_INSEE);
+            printf("\nUsing %s, enter an INSEE code to choose another one.\n",
+                   NameIndex_getMunicipality(index, first)->code_commune_INSEE);
+            printf("\033[0m");
         }
-        free(iter);
+        if (count > 0)
+            return NameIndex_getMunicipality(index, first);
     }
     // Sinon on retourne null :
     return NULL;
@@ -306,12 +496,14 @@ Municipalities *getMunicipality(Dict *dict, char *input) {
 /// @return Retourne un tableau de structures communes adjacentes à celle donnée.
 /// @author Arthur
 Municipalities **getAdj(Municipalities *municipality, Graph *graph, Municipalities **array, int *size) {
-    // Récupère les successeurs de la commune dans le graph.
-    Arc *adjacentsNodes = Graph_getSuccessors(graph, municipality->id, size);
-    Municipalities **adjacents = calloc(*size, sizeof(Municipalities));
+    // Parcourt les successeurs de la commune dans le graph.
+    ArcIter iter;
+    *size = Graph_getPositiveValency(graph, municipality->id);
+    Municipalities **adjacents = calloc(*size, sizeof(Municipalities *));
+    Graph_getSuccessorIterator(graph, municipality->id, &iter);
     // Pour chaque successeur, on associe la commune correspondante :
-    for (int i = 0; i < *size; ++i) {
-        adjacents[i] = array[adjacentsNodes[i].target];
+    for (int i = 0; ArcIter_hasNext(&iter); ++i) {
+        adjacents[i] = array[ArcIter_next(&iter)->target];
     }
     // Retourne le tableau de communes adjacentes.
     return adjacents;
@@ -344,18 +536,113 @@ double computeDistance(double latitude1, double longitude1, double latitude2, do
 /// @author Adrien
 void municipalityWeight(Graph *municipalitiesGraph, Municipalities **municipalitiesList, int count) {
     for (int i = 0; i < count; i++) {
-        int size;
-        Arc *arc = Graph_getSuccessors(municipalitiesGraph, i, &size);
-        for (int j = 0; j < Graph_getPositiveValency(municipalitiesGraph, i); j++) {
-            Graph_set(municipalitiesGraph, i, arc[j].target,
+        ArcIter iter;
+        Graph_getSuccessorIterator(municipalitiesGraph, i, &iter);
+        while (ArcIter_hasNext(&iter)) {
+            Arc *arc = ArcIter_next(&iter);
+            Graph_set(municipalitiesGraph, i, arc->target,
                       computeDistance(municipalitiesList[i]->latitude, municipalitiesList[i]->longitude,
-                                      municipalitiesList[arc[j].target]->latitude,
-                                      municipalitiesList[arc[j].target]->longitude));
+                                      municipalitiesList[arc->target]->latitude,
+                                      municipalitiesList[arc->target]->longitude));
         }
-        free(arc);
     }
 }
 
+/// @brief Pondère les arcs selon le nombre de bars autour de la commune d'arrivée.
+/// Le poids de chaque arc arrivant à une commune est divisé par le nombre de bars
+/// situés dans la grille autour de celle-ci (plus un).
+/// @param municipalitiesGraph Le graphe.
+/// @param municipalitiesList Le tableau des municipalités.
+/// @param count Le nombre total de communes.
+/// @param grid La grille des POI.
+/// @return Retourne le tableau du nombre de bars autour de chaque commune.
+int *barsWeight(Graph *municipalitiesGraph, Municipalities **municipalitiesList, int count, GridCell **grid) {
+    int *barCounts = calloc(count, sizeof(int));
+    // Passage par toutes les communes.
+    for (int i = 0; i < count; i++) {
+        if (!municipalitiesList[i] || municipalitiesList[i]->latitude == 0 || municipalitiesList[i]->longitude == 0 ||
+            municipalitiesList[i]->longitude < -6 || municipalitiesList[i]->longitude > 10 ||
+            municipalitiesList[i]->latitude < 40 || municipalitiesList[i]->latitude > 53)
+            continue;
+        int compteur = 0;
+        // Calcule de la position de la commune.
+        int x = floor((municipalitiesList[i]->latitude - GRID_MIN_LAT) / CELL_SIZE);
+        int y = floor((municipalitiesList[i]->longitude - GRID_MIN_LON) / CELL_SIZE);
+
+        // Récupération des bars.
+        for (int a = x - RAYON; a < x + RAYON; a++) {
+            for (int b = y - RAYON; b < y + RAYON; b++) {
+                if (a <= 0 || a >= 1000 || b <= 0 || b >= 1000)
+                    continue;
+                compteur += grid[a][b].poiList->nodeCount;
+            }
+        }
+        barCounts[i] = compteur;
+
+        if (compteur <= 0)
+            continue;
+
+        ArcIter iter;
+        Graph_getPredecessorIterator(municipalitiesGraph, i, &iter);
+        while (ArcIter_hasNext(&iter)) {
+            Arc *arc = ArcIter_next(&iter);
+            Graph_set(municipalitiesGraph, arc->source, i, arc->weight / (compteur + 1));
+        }
+    }
+    return barCounts;
+}
+
+/// @brief Crée les communes et leur dictionnaire à partir d'un instantané.
+/// Les chaînes de caractères des communes désignent directement le contenu de l'instantané.
+/// @param snapshot L'instantané.
+/// @param arena L'arène dans laquelle allouer les communes.
+/// @param dict Pointeur vers le dictionnaire INSEE - Structure commune à créer.
+/// @return Retourne le tableau des structures communes.
+Municipalities *snapshotParse(Snapshot *snapshot, Arena *arena, FrozenDict **dict) {
+    Municipalities *municipalities = Arena_alloc(arena, snapshot->nodeCount * sizeof(Municipalities));
+    KVPair *pairs = calloc(snapshot->nodeCount > 0 ? snapshot->nodeCount : 1, sizeof(KVPair));
+    AssertNew(pairs);
+    int pairCount = 0;
+    for (int i = 0; i < snapshot->nodeCount; i++) {
+        SnapshotMunicipality *record = &snapshot->municipalities[i];
+        if (record->nameOffset < 0)
+            continue;
+        Municipalities *municipality = &municipalities[i];
+        municipality->id = i;
+        municipality->code_commune_INSEE = record->code;
+        municipality->nom_commune_postal = snapshot->strings + record->nameOffset;
+        municipality->latitude = record->latitude;
+        municipality->longitude = record->longitude;
+        pairs[pairCount].key = municipality->code_commune_INSEE;
+        pairs[pairCount].value = municipality;
+        pairCount++;
+    }
+    *dict = FrozenDict_createFromArray(pairs, pairCount);
+    free(pairs);
+    return municipalities;
+}
+
+/// @brief Affiche les statistiques d'un trajet.
+/// @param path Le chemin.
+/// @param barCounts Le nombre de bars autour de chaque commune.
+void pathStatsPrint(Path *path, int *barCounts) {
+    // Calcule du nombre de bars selon les communes où passe le trajet.
+    int compteurTotal = 0;
+    int compteurPoi = 0;
+
+    IntListNode *sentinel = &(path->list->sentinel);
+    for (IntListNode *curr = sentinel->next; curr != sentinel; curr = curr->next) {
+        compteurTotal += barCounts[curr->value];
+        if (barCounts[curr->value] > 0)
+            compteurPoi++;
+    }
+
+    printf("Nombre total de bars: %d \n", compteurTotal);
+    printf("Nombre total de communes de passage: %d \n", path->list->nodeCount);
+    printf("Communes de passage avec bars: %d \n", compteurPoi);
+    printf("Communes de passage sans bars: %d ", path->list->nodeCount - compteurPoi);
+}
+
 /// @brief Crée un objet cJSON à partir d'un template.
 /// @return Retourne l'objet cJSON créé.
 /// @author Arthur
@@ -421,37 +708,6 @@ void jsonGenerate(Path *path, FILE *file, Municipalities **arr) {
 }
 
 
-void municipalitiesDict_destroy(Dict *municipalitiesDict) {
-    DictIter *iter = calloc(1, sizeof(DictIter));
-    Dict_getIterator(municipalitiesDict, iter);
-    while (DictIter_hasNext(iter)) {
-        KVPair *pair = DictIter_next(iter);
-        if (!pair) continue;
-        Municipalities *value = pair->value;
-        free(value->code_commune_INSEE);
-        free(value->nom_commune_postal);
-        free(value);
-    }
-    free(iter);
-    Dict_destroy(municipalitiesDict);
-}
-
-
-void poi_destroy(Dict *poiDict) {
-    DictIter *iter = calloc(1, sizeof(DictIter));
-    Dict_getIterator(poiDict, iter);
-    while (DictIter_hasNext(iter)) {
-        KVPair *pair = DictIter_next(iter);
-        if (!pair) continue;
-        Poi *value = pair->value;
-        free(value->name);
-        free(value);
-    }
-    free(iter);
-    Dict_destroy(poiDict);
-}
-
-
 void grid_destroy(GridCell **grid) {
     for (int i = 0; i < GRID_WIDTH; ++i) {
         for (int j = 0; j < GRID_HEIGHT; ++j) {
@@ -473,72 +729,111 @@ int main(int argc, char *argv[]) {
     char *path_adjacentMunicipalities = "./Data/communes_adjacentes.csv";
     char *path_poi = "./Data/poi.csv";
     char *path_map = "./Data/map.geojson";
-    UniStr *commaSeparator = UniStr_decodeU8(u8",", -1);
-    UniStr *tabulationSeparator = UniStr_decodeU8(u8"\t", -1);
+    char *path_snapshot = NULL;
+    bool buildSnapshot = false;
+    bool completeOnly = false;
+    int argStart = 1;
+
+    FrozenDict *municipalitiesDict = NULL;
+    FrozenDict *poiDict = NULL;
+    Graph *municipalitiesGraph = NULL;
+    Municipalities **municipalitiesList = NULL;
+    Arena *arena = Arena_create(0);
+    Snapshot *snapshot = NULL;
+    InseeMap *inseeMap = NULL;
+    int *barCounts = NULL;
+
+
+    // Choix du mode de lancement.
+    if (argc > 1 && !strcmp(argv[1], "--build-snapshot")) {
+        buildSnapshot = true;
+        path_snapshot = argc > 2 ? argv[2] : "./Data/snapshot.bin";
+        argStart = 3;
+    } else if (argc > 1 && !strcmp(argv[1], "--snapshot")) {
+        path_snapshot = argc > 2 ? argv[2] : "./Data/snapshot.bin";
+        argStart = 3;
+    }
 
 
-    // Ouverture des fichiers.
-    FILE *input_municipalities = fopen(path_municipalities, "r");
-    if (!input_municipalities) {
-        err_open(1, path_municipalities);
-        return EXIT_FAILURE;
-    }
-    err_open(0, path_municipalities);
+    if (path_snapshot && !buildSnapshot) {
+        // Chargement de l'instantané du graphe préparé.
+        snapshot = Snapshot_open(path_snapshot);
+        if (!snapshot) {
+            err_parse(1, path_snapshot);
+            return EXIT_FAILURE;
+        }
+        err_parse(0, path_snapshot);
+
+        municipalitiesCount = snapshot->nodeCount;
+        snapshotParse(snapshot, arena, &municipalitiesDict);
+        inseeMap = inseeMapCreate(municipalitiesDict);
+        municipalitiesGraph = Graph_createCsr(municipalitiesCount, snapshot->offsets, snapshot->targets,
+                                              snapshot->weights);
+        barCounts = calloc(municipalitiesCount, sizeof(int));
+        for (int i = 0; i < municipalitiesCount; i++) {
+            barCounts[i] = snapshot->municipalities[i].barCount;
+        }
+    } else {
+        // Ouverture des fichiers.
+        CsvReader *input_municipalities = CsvReader_open(path_municipalities, ',');
+        if (!input_municipalities) {
+            err_open(1, path_municipalities);
+            return EXIT_FAILURE;
+        }
+        err_open(0, path_municipalities);
 
-    FILE *input_adjacentMunicipalities = fopen(path_adjacentMunicipalities, "r");
-    if (!input_adjacentMunicipalities) {
-        err_open(1, path_adjacentMunicipalities);
-        return EXIT_FAILURE;
-    }
-    err_open(0, path_adjacentMunicipalities);
+        CsvReader *input_adjacentMunicipalities = CsvReader_open(path_adjacentMunicipalities, ',');
+        if (!input_adjacentMunicipalities) {
+            err_open(1, path_adjacentMunicipalities);
+            return EXIT_FAILURE;
+        }
+        err_open(0, path_adjacentMunicipalities);
 
-    FILE *input_poi = fopen(path_poi, "r");
-    if (!input_poi) {
-        err_open(1, path_poi);
-        return EXIT_FAILURE;
-    }
-    err_open(0, path_poi);
+        CsvReader *input_poi = CsvReader_open(path_poi, '\t');
+        if (!input_poi) {
+            err_open(1, path_poi);
+            return EXIT_FAILURE;
+        }
+        err_open(0, path_poi);
 
-    FILE *output_map = fopen(path_map, "w+");
-    if (!output_map) {
-        err_open(1, path_map);
-        return EXIT_FAILURE;
-    }
-    err_open(0, path_map);
 
+        // Lecture fichiers des communes et création tableau de struct communes.
+        municipalitiesDict = municipalitiesParse(input_municipalities, arena, &municipalitiesCount);
+        if (!municipalitiesDict) {
+            err_parse(1, path_municipalities);
+            return EXIT_FAILURE;
+        }
+        err_parse(0, path_municipalities);
+        municipalitiesReorder(municipalitiesDict, municipalitiesCount);
+        inseeMap = inseeMapCreate(municipalitiesDict);
 
-    // Lecture fichiers des communes et création tableau de struct communes.
-    Dict *municipalitiesDict = municipalitiesParse(input_municipalities, commaSeparator,
-                                                   &municipalitiesCount);
-    if (!municipalitiesDict) {
-        err_parse(1, path_municipalities);
-        return EXIT_FAILURE;
-    }
-    err_parse(0, path_municipalities);
 
+        // Génération du graph à partir de la lecture du fichier des communes adjacentes.
+        municipalitiesGraph = adjMunicipalitiesParse(input_adjacentMunicipalities, municipalitiesCount,
+                                                     inseeMap);
+        if (!municipalitiesGraph) {
+            err_parse(1, path_adjacentMunicipalities);
+            return EXIT_FAILURE;
+        }
+        err_parse(0, path_adjacentMunicipalities);
 
-    // Génération du graph à partir de la lecture du fichier des communes adjacentes.
-    Graph *municipalitiesGraph = adjMunicipalitiesParse(input_adjacentMunicipalities, commaSeparator,
-                                                        municipalitiesCount,
-                                                        municipalitiesDict);
-    if (!municipalitiesGraph) {
-        err_parse(1, path_adjacentMunicipalities);
-        return EXIT_FAILURE;
-    }
-    err_parse(0, path_adjacentMunicipalities);
 
+        // Lecture du fichier des POI.
+        poiDict = poiParse(input_poi, arena, &poiCount);
+        if (!poiDict) {
+            err_parse(1, path_poi);
+            return EXIT_FAILURE;
+        }
+        err_parse(0, path_poi);
 
-    // Génération du graph à partir de la lecture du fichier des communes adjacentes.
-    Dict *poiDict = poiParse(input_poi, tabulationSeparator, &poiCount);
-    if (!poiDict) {
-        err_parse(1, path_poi);
-        return EXIT_FAILURE;
+        CsvReader_close(input_poi);
+        CsvReader_close(input_municipalities);
+        CsvReader_close(input_adjacentMunicipalities);
     }
-    err_parse(0, path_poi);
 
 
     // Génération du tableau liant l'ID de la commune à sa structure.
-    Municipalities **municipalitiesList = linkIdToStruct(municipalitiesCount, municipalitiesDict);
+    municipalitiesList = linkIdToStruct(municipalitiesCount, municipalitiesDict);
     if (!municipalitiesList) {
         printf("\033[0;31m");
         printf("ERROR: Can't link structs to IDs.\n");
@@ -550,192 +845,167 @@ int main(int argc, char *argv[]) {
     printf("\033[0m");
 
 
-    // Vérification de la ville de départ.
-    if (argc < 2) {
-        printf("\033[0;31m");
-        printf("\nERROR: You have not specified a departure city.\n"
-               "Enter your departure city: ");
-        printf("\033[0m");
-        scanf("%s", input_start);
+    // Index des noms des communes (déjà construit dans un instantané).
+    NameIndex *nameIndex = NULL;
+    if (snapshot) {
+        nameIndex = NameIndex_createBorrowed(municipalitiesList, snapshot->nameCount, snapshot->nameIds,
+                                             snapshot->nameOffsets, snapshot->names, snapshot->nameSlots,
+                                             snapshot->nameCapacity);
     } else {
-        stpcpy(input_start, argv[1]);
-    }
-    Municipalities *start = getMunicipality(municipalitiesDict, input_start);
-    while (!start) {
-        printf("\033[0;31m");
-        printf("\nERROR: Departure city not found.\n"
-               "Try again: ");
-        printf("\033[0m");
-        scanf("%s", input_start);
-        start = getMunicipality(municipalitiesDict, input_start);
+        nameIndex = NameIndex_create(municipalitiesList, municipalitiesCount);
     }
-    printf("\033[0;32m");
-    printf("INFO: Departure city found.\n");
-    printf("\033[0m");
 
 
-    // Vérification de la ville d'arrivée.
-    if (argc < 3) {
-        printf("\033[0;31m");
-        printf("\nERROR: You have not specified an arrival city.\n"
-               "Enter your city of arrival: ");
-        printf("\033[0m");
-        scanf("%s", input_end);
-    } else {
-        stpcpy(input_end, argv[2]);
-    }
-    Municipalities *end = getMunicipality(municipalitiesDict, input_end);
-    while (!end) {
-        printf("\033[0;31m");
-        printf("\nERROR: Arrival city not found.\n"
-               "Try again: ");
-        printf("\033[0m");
-        scanf("%s", input_end);
-        end = getMunicipality(municipalitiesDict, input_end);
+    // Suggestions de noms de communes.
+    if (argc > argStart && !strcmp(argv[argStart], "--complete")) {
+        int maxCount = argc > argStart + 2 ? atoi(argv[argStart + 2]) : 10;
+        int count = 0;
+        int first = NameIndex_complete(nameIndex, argc > argStart + 1 ? argv[argStart + 1] : "", maxCount, &count);
+        for (int i = first; i < first + count; i++) {
+            Municipalities *municipality = NameIndex_getMunicipality(nameIndex, i);
+            printf("%s %s\n", municipality->code_commune_INSEE, municipality->nom_commune_postal);
+        }
+        completeOnly = true;
     }
-    printf("\033[0;32m");
-    printf("INFO: Arrival city found.\n");
-    printf("\033[0m");
-
-
-    municipalityWeight(municipalitiesGraph, municipalitiesList, municipalitiesCount);
 
-    // Creation de la grille de la France.
-    GridCell **grid = createGrid();
 
-    DictIter *iter = calloc(1, sizeof(DictIter));
-    Dict_getIterator(poiDict, iter);
-    // Tant qu'il y a des poi dans le dictionnaire :
-    while (DictIter_hasNext(iter)) {
-        KVPair *pair = DictIter_next(iter);
-        if (!pair) continue;
-        Poi *value = pair->value;
-        // Appelle de la fonction pour ajouter les poi dans la grille.
-        addPOI(grid, value);
-    }
+    // Pondération des arcs (déjà effectuée dans un instantané).
+    if (!snapshot && !completeOnly) {
+        municipalityWeight(municipalitiesGraph, municipalitiesList, municipalitiesCount);
 
-    // Passage par toutes les communes.
-    for (int i = 0; i < municipalitiesCount; i++) {
-        if (!municipalitiesList[i] || municipalitiesList[i]->latitude == 0 || municipalitiesList[i]->longitude == 0 ||
-            municipalitiesList[i]->longitude < -6 || municipalitiesList[i]->longitude > 10 ||
-            municipalitiesList[i]->latitude < 40 || municipalitiesList[i]->latitude > 53)
-            continue;
-        int compteur = 0;
-        // Calcule de la position de la commune.
-        int x = floor((municipalitiesList[i]->latitude - GRID_MIN_LAT) / CELL_SIZE);
-        int y = floor((municipalitiesList[i]->longitude - GRID_MIN_LON) / CELL_SIZE);
+        // Creation de la grille de la France.
+        GridCell **grid = createGrid();
 
-        // Récupération des bars.
-        for (int a = x - RAYON; a < x + RAYON; a++) {
-            for (int b = y - RAYON; b < y + RAYON; b++) {
-                if (a <= 0 || a >= 1000 || b <= 0 || b >= 1000)
-                    continue;
-                compteur += grid[a][b].poiList->nodeCount;
-            }
+        FrozenDictIter *iter = calloc(1, sizeof(FrozenDictIter));
+        FrozenDict_getIterator(poiDict, iter);
+        // Tant qu'il y a des poi dans le dictionnaire :
+        while (FrozenDictIter_hasNext(iter)) {
+            const KVPair *pair = FrozenDictIter_next(iter);
+            if (!pair) continue;
+            Poi *value = pair->value;
+            // Appelle de la fonction pour ajouter les poi dans la grille.
+            addPOI(grid, value);
         }
+        free(iter);
 
-
-        int predecessorsSize;
-        Arc *arc = Graph_getPredecessors(municipalitiesGraph, i, &predecessorsSize);
-
-        for (int m = 0; m < predecessorsSize; m++) {
-            if (compteur > 0) {
-                float value = Graph_get(municipalitiesGraph, arc[m].source, i) / (compteur + 1);
-                Graph_set(municipalitiesGraph, arc[m].source, i, value);
-            }
-        }
-        free(arc);
+        barCounts = barsWeight(municipalitiesGraph, municipalitiesList, municipalitiesCount, grid);
+        grid_destroy(grid);
     }
 
 
+    // Écriture de l'instantané.
+    if (completeOnly) {
+        // Rien à faire de plus.
+    } else if (buildSnapshot) {
+        if (!Snapshot_write(path_snapshot, municipalitiesGraph, municipalitiesList, barCounts,
+                            nameIndex)) {
+            printf("\033[0;31m");
+            printf("ERROR: Can't write %s file.\n", path_snapshot);
+            printf("\033[0m");
+            return EXIT_FAILURE;
+        }
+        printf("\033[0;32m");
+        printf("INFO: Snapshot successfully generated at %s.\n", path_snapshot);
+        printf("\033[0m");
+    } else {
+        FILE *output_map = fopen(path_map, "w+");
+        if (!output_map) {
+            err_open(1, path_map);
+            return EXIT_FAILURE;
+        }
+        err_open(0, path_map);
 
-    // Algorithme plus court chemin.
-    Path *path = Graph_shortestPath(municipalitiesGraph, start->id, end->id);
-
-
-
-    // Calcule du nombre de bars selon les communes où passe le trajet.
-    int compteurTotal = 0;
-    int compteurPoi = 0;
-    int checkPoi = 0;
-    int *communesCheck = calloc(path->list->nodeCount, sizeof(int));
-    int index = 0;
-
-    IntList *list = path->list;
-    IntListNode *sentinel = &(list->sentinel);
-    IntListNode *curr = sentinel->next;
-    while (curr != sentinel->prev) {
-        communesCheck[index] = curr->value;
-        index++;
-        curr = curr->next;
-    }
-    if (curr != sentinel) {
-        communesCheck[index] = curr->value;
-        index++;
-    }
 
-    // Passage par toutes les communes.
-    for (int i = 0; i < path->list->nodeCount; i++) {
-        if (!municipalitiesList[i] || municipalitiesList[i]->latitude == 0 || municipalitiesList[i]->longitude == 0 ||
-            municipalitiesList[i]->longitude < -6 || municipalitiesList[i]->longitude > 10 ||
-            municipalitiesList[i]->latitude < 40 || municipalitiesList[i]->latitude > 53) {
-            continue;
+        // Vérification de la ville de départ.
+        if (argc < argStart + 1) {
+            printf("\033[0;31m");
+            printf("\nERROR: You have not specified a departure city.\n"
+                   "Enter your departure city: ");
+            printf("\033[0m");
+            if (!inputRead(input_start))
+                return EXIT_FAILURE;
+        } else {
+            stpcpy(input_start, argv[argStart]);
         }
-        // Calcule de la position de la commune.
-        int x = floor((municipalitiesList[i]->latitude - GRID_MIN_LAT) / CELL_SIZE);
-        int y = floor((municipalitiesList[i]->longitude - GRID_MIN_LON) / CELL_SIZE);
+        Municipalities *start = getMunicipality(inseeMap, municipalitiesList, nameIndex, input_start);
+        while (!start) {
+            printf("\033[0;31m");
+            printf("\nERROR: Departure city not found.\n");
+            printf("\033[0m");
+            suggestionsPrint(nameIndex, input_start);
+            printf("\033[0;31m");
+            printf("Try again: ");
+            printf("\033[0m");
+            if (!inputRead(input_start))
+                return EXIT_FAILURE;
+            start = getMunicipality(inseeMap, municipalitiesList, nameIndex, input_start);
+        }
+        printf("\033[0;32m");
+        printf("INFO: Departure city found.\n");
+        printf("\033[0m");
 
-        checkPoi = 0;
 
-        // Calcule dans le périmètre de la commune du nombre de bar.
-        for (int a = x - RAYON; a < x + RAYON; a++) {
-            for (int b = y - RAYON; b < y + RAYON; b++) {
-                if (a <= 0 || a >= 1000 || b <= 0 || b >= 1000)
-                    continue;
-                compteurTotal += grid[a][b].poiList->nodeCount;
-                if (grid[a][b].poiList->nodeCount == 0) {
-                    checkPoi++;
-                }
-            }
+        // Vérification de la ville d'arrivée.
+        if (argc < argStart + 2) {
+            printf("\033[0;31m");
+            printf("\nERROR: You have not specified an arrival city.\n"
+                   "Enter your city of arrival: ");
+            printf("\033[0m");
+            if (!inputRead(input_end))
+                return EXIT_FAILURE;
+        } else {
+            stpcpy(input_end, argv[argStart + 1]);
         }
-        if (checkPoi > 0) {
-            compteurPoi++;
+        Municipalities *end = getMunicipality(inseeMap, municipalitiesList, nameIndex, input_end);
+        while (!end) {
+            printf("\033[0;31m");
+            printf("\nERROR: Arrival city not found.\n");
+            printf("\033[0m");
+            suggestionsPrint(nameIndex, input_end);
+            printf("\033[0;31m");
+            printf("Try again: ");
+            printf("\033[0m");
+            if (!inputRead(input_end))
+                return EXIT_FAILURE;
+            end = getMunicipality(inseeMap, municipalitiesList, nameIndex, input_end);
         }
-    }
+        printf("\033[0;32m");
+        printf("INFO: Arrival city found.\n");
+        printf("\033[0m");
 
 
-    printf("Nombre total de bars: %d \n", compteurTotal);
-    printf("Nombre total de communes de passage: %d \n", path->list->nodeCount);
-    printf("Communes de passage avec bars: %d \n", compteurPoi);
-    printf("Communes de passage sans bars: %d ", path->list->nodeCount - compteurPoi);
+        // Algorithme plus court chemin.
+        Path *path = Graph_shortestPath(municipalitiesGraph, start->id, end->id);
 
 
+        // Statistiques du trajet.
+        pathStatsPrint(path, barCounts);
 
-    // Génération du fichier geojson.
-    jsonGenerate(path, output_map, municipalitiesList);
-    printf("\033[0;32m");
-    printf("\nINFO: Output file successfully generated at %s.\n", path_map);
-    printf("\033[0m");
+
+        // Génération du fichier geojson.
+        jsonGenerate(path, output_map, municipalitiesList);
+        printf("\033[0;32m");
+        printf("\nINFO: Output file successfully generated at %s.\n", path_map);
+        printf("\033[0m");
+
+        fclose(output_map);
+        Path_destroy(path);
+    }
 
 
     // Libération de la mémoire.
-    free(iter);
     free(input_end);
     free(input_start);
-    free(communesCheck);
-    fclose(input_poi);
-    fclose(output_map);
-    fclose(input_municipalities);
-    fclose(input_adjacentMunicipalities);
-    Path_destroy(path);
-    poi_destroy(poiDict);
-    municipalitiesDict_destroy(municipalitiesDict);
+    free(barCounts);
+    NameIndex_destroy(nameIndex);
+    InseeMap_destroy(inseeMap);
     free(municipalitiesList);
-    grid_destroy(grid);
     Graph_destroy(municipalitiesGraph);
-    UniStr_destroy(commaSeparator);
-    UniStr_destroy(tabulationSeparator);
+    FrozenDict_destroy(poiDict);
+    FrozenDict_destroy(municipalitiesDict);
+    Arena_destroy(arena);
+    Snapshot_close(snapshot);
 
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
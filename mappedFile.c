@@ -0,0 +1,77 @@
+#include "mappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile_open(const char *filename, void **data, size_t *size)
+{
+    *data = NULL;
+    *size = 0;
+
+#ifdef _WIN32
+    FILE *input = fopen(filename, "rb");
+    if (!input)
+        return false;
+    fseek(input, 0, SEEK_END);
+    long fileSize = ftell(input);
+    fseek(input, 0, SEEK_SET);
+    if (fileSize < 0)
+    {
+        fclose(input);
+        return false;
+    }
+    if (fileSize > 0)
+    {
+        void *buffer = malloc((size_t)fileSize);
+        AssertNew(buffer);
+        if (fread(buffer, 1, (size_t)fileSize, input) != (size_t)fileSize)
+        {
+            free(buffer);
+            fclose(input);
+            return false;
+        }
+        *data = buffer;
+        *size = (size_t)fileSize;
+    }
+    fclose(input);
+    return true;
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    if (st.st_size > 0)
+    {
+        void *mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            close(fd);
+            return false;
+        }
+        *data = mapping;
+        *size = (size_t)st.st_size;
+    }
+    close(fd);
+    return true;
+#endif
+}
+
+void MappedFile_close(void *data, size_t size)
+{
+    if (!data) return;
+
+#ifdef _WIN32
+    free(data);
+#else
+    munmap(data, size);
+#endif
+}
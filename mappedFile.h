@@ -0,0 +1,18 @@
+#pragma once
+
+#include "settings.h"
+
+/// @brief Projette un fichier en mémoire en lecture seule.
+/// Sur les systèmes ne disposant pas de mmap(), le fichier est lu dans un
+/// buffer alloué.
+/// @param filename chemin du fichier.
+/// @param[out] data adresse où écrire le début du fichier en mémoire
+/// (NULL si le fichier est vide).
+/// @param[out] size adresse où écrire la taille du fichier en octets.
+/// @return true si le fichier a pu être ouvert, false sinon.
+bool MappedFile_open(const char *filename, void **data, size_t *size);
+
+/// @brief Libère un fichier projeté avec MappedFile_open().
+/// @param data le début du fichier en mémoire.
+/// @param size la taille du fichier en octets.
+void MappedFile_close(void *data, size_t size);
@@ -2,6 +2,8 @@
 // Created by DUMOND on 03/05/2023.
 //
 
+#pragma once
+
 typedef struct sMunicipalities Municipalities;
 typedef struct sPoi Poi;
 
@@ -0,0 +1,517 @@
+#include "nameIndex.h"
+#include "uniStr.h"
+
+/// @brief Calcule la valeur de hachage d'un nom normalisé (FNV-1a).
+INLINE uint32_t NameIndex_hash(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    for (; *name; name++)
+    {
+        hash ^= (unsigned char)*name;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/// @brief Couple nom normalisé/commune utilisé pour trier l'index.
+typedef struct sNameEntry
+{
+    char *name;
+    Municipalities *municipality;
+} NameEntry;
+
+/// @brief Compare deux communes par nom normalisé puis par numéro INSEE.
+int NameEntry_compare(const void *a, const void *b)
+{
+    const NameEntry *entryA = (const NameEntry *)a;
+    const NameEntry *entryB = (const NameEntry *)b;
+    int cmp = strcmp(entryA->name, entryB->name);
+    if (cmp != 0)
+        return cmp;
+    return strcmp(
+        entryA->municipality->code_commune_INSEE,
+        entryB->municipality->code_commune_INSEE
+    );
+}
+
+char *NameIndex_normalize(const char *name)
+{
+    // Le nom normalisé n'est jamais plus long que le nom d'origine.
+    int bufferSize = (int)strlen(name) + 1;
+    char *normalized = (char *)calloc(bufferSize, sizeof(char));
+    AssertNew(normalized);
+    UniStr_normalizeU8(name, normalized, bufferSize);
+    return normalized;
+}
+
+/// @brief Taille du buffer local dans lequel les requêtes sont normalisées.
+#define NAME_INDEX_QUERY_SIZE 128
+
+/// @brief Normalise une requête dans un buffer local de taille
+/// NAME_INDEX_QUERY_SIZE, ou dans un buffer alloué si elle est trop longue.
+/// @return Le nom normalisé, à libérer avec free() s'il est différent de
+/// buffer.
+static char *NameIndex_normalizeQuery(const char *query, char *buffer)
+{
+    if (strlen(query) < NAME_INDEX_QUERY_SIZE)
+    {
+        UniStr_normalizeU8(query, buffer, NAME_INDEX_QUERY_SIZE);
+        return buffer;
+    }
+    return NameIndex_normalize(query);
+}
+
+NameIndex *NameIndex_create(Municipalities **municipalities, int count)
+{
+    NameIndex *index = (NameIndex *)calloc(1, sizeof(NameIndex));
+    AssertNew(index);
+    index->municipalities = municipalities;
+
+    // Normalisation et tri des noms.
+    NameEntry *entries = (NameEntry *)calloc(count > 0 ? count : 1, sizeof(NameEntry));
+    AssertNew(entries);
+    size_t namesSize = 0;
+    for (int i = 0; i < count; i++)
+    {
+        Municipalities *municipality = municipalities[i];
+        if (!municipality || !municipality->nom_commune_postal)
+            continue;
+
+        NameEntry *entry = &entries[index->count++];
+        entry->name = NameIndex_normalize(municipality->nom_commune_postal);
+        entry->municipality = municipality;
+        namesSize += strlen(entry->name) + 1;
+    }
+    qsort(entries, index->count, sizeof(NameEntry), NameEntry_compare);
+
+    // Tableaux triés et table des noms (les homonymes partagent leur nom).
+    index->ids = (int32_t *)calloc(index->count > 0 ? index->count : 1, sizeof(int32_t));
+    index->nameOffsets = (int32_t *)calloc(index->count > 0 ? index->count : 1, sizeof(int32_t));
+    index->names = (char *)calloc(namesSize > 0 ? namesSize : 1, sizeof(char));
+    AssertNew(index->ids);
+    AssertNew(index->nameOffsets);
+    AssertNew(index->names);
+    size_t namesIdx = 0;
+    for (int i = 0; i < index->count; i++)
+    {
+        index->ids[i] = entries[i].municipality->id;
+        if (i > 0 && strcmp(entries[i - 1].name, entries[i].name) == 0)
+        {
+            index->nameOffsets[i] = index->nameOffsets[i - 1];
+            continue;
+        }
+        size_t nameSize = strlen(entries[i].name) + 1;
+        Memcpy(index->names + namesIdx, nameSize, entries[i].name, nameSize);
+        index->nameOffsets[i] = (int32_t)namesIdx;
+        namesIdx += nameSize;
+    }
+    for (int i = 0; i < index->count; i++)
+        free(entries[i].name);
+    free(entries);
+
+    // Table de hachage des noms distincts, remplie au plus à moitié.
+    index->capacity = 16;
+    while (index->capacity < 2 * index->count)
+        index->capacity *= 2;
+    index->slots = (int32_t *)calloc(index->capacity, sizeof(int32_t));
+    AssertNew(index->slots);
+    for (int i = 0; i < index->capacity; i++)
+        index->slots[i] = -1;
+
+    int mask = index->capacity - 1;
+    for (int i = 0; i < index->count; i++)
+    {
+        if (i > 0 && index->nameOffsets[i - 1] == index->nameOffsets[i])
+            continue;
+
+        int slot = (int)(NameIndex_hash(NameIndex_getName(index, i)) & mask);
+        while (index->slots[slot] >= 0)
+            slot = (slot + 1) & mask;
+        index->slots[slot] = i;
+    }
+
+    return index;
+}
+
+NameIndex *NameIndex_createBorrowed(
+    Municipalities **municipalities, int count,
+    int32_t *ids, int32_t *nameOffsets, char *names,
+    int32_t *slots, int capacity)
+{
+    assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+
+    NameIndex *index = (NameIndex *)calloc(1, sizeof(NameIndex));
+    AssertNew(index);
+
+    index->count = count;
+    index->ids = ids;
+    index->nameOffsets = nameOffsets;
+    index->names = names;
+    index->slots = slots;
+    index->capacity = capacity;
+    index->municipalities = municipalities;
+    index->borrowed = true;
+
+    return index;
+}
+
+void NameIndex_destroy(NameIndex *index)
+{
+    if (!index) return;
+
+    if (!index->borrowed)
+    {
+        free(index->ids);
+        free(index->nameOffsets);
+        free(index->names);
+        free(index->slots);
+    }
+    free(index->trigramOffsets);
+    free(index->trigramPostings);
+    free(index->trigramScores);
+    free(index->trigramTouched);
+    free(index->trigramCounts);
+    free(index);
+}
+
+size_t NameIndex_getNamesSize(NameIndex *index)
+{
+    if (index->count <= 0)
+        return 0;
+
+    // Le dernier nom de la table est celui de la dernière commune.
+    const char *last = NameIndex_getName(index, index->count - 1);
+    return (size_t)(last - index->names) + strlen(last) + 1;
+}
+
+int NameIndex_find(NameIndex *index, const char *name, int *count)
+{
+    char buffer[NAME_INDEX_QUERY_SIZE];
+    char *normalized = NameIndex_normalizeQuery(name, buffer);
+    int res = -1;
+    *count = 0;
+
+    int mask = index->capacity - 1;
+    int slot = (int)(NameIndex_hash(normalized) & mask);
+    while (index->slots[slot] >= 0)
+    {
+        int first = index->slots[slot];
+        if (strcmp(NameIndex_getName(index, first), normalized) == 0)
+        {
+            // Les homonymes partagent le même nom dans la table.
+            int last = first + 1;
+            while (last < index->count && index->nameOffsets[last] == index->nameOffsets[first])
+                last++;
+            res = first;
+            *count = last - first;
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if (normalized != buffer)
+        free(normalized);
+    return res;
+}
+
+int NameIndex_complete(NameIndex *index, const char *prefix, int maxCount, int *count)
+{
+    char buffer[NAME_INDEX_QUERY_SIZE];
+    char *normalized = NameIndex_normalizeQuery(prefix, buffer);
+    size_t prefixLength = strlen(normalized);
+    *count = 0;
+
+    // Recherche dichotomique du premier nom supérieur ou égal au préfixe.
+    int lo = 0, hi = index->count;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (strcmp(NameIndex_getName(index, mid), normalized) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    int last = lo;
+    while (last < index->count && last - lo < maxCount &&
+        strncmp(NameIndex_getName(index, last), normalized, prefixLength) == 0)
+    {
+        last++;
+    }
+    if (normalized != buffer)
+        free(normalized);
+
+    *count = last - lo;
+    return *count > 0 ? lo : -1;
+}
+
+/// @brief Calcule les valeurs de hachage des trigrammes d'un nom normalisé.
+/// Le nom est précédé de deux espaces et suivi d'un espace, pour que les
+/// débuts et fins de mots aient leurs propres trigrammes.
+/// @param name le nom.
+/// @param[out] buckets tableau de strlen(name) + 1 cases.
+/// @return Le nombre de trigrammes distincts écrits dans buckets.
+static int NameIndex_getTrigrams(const char *name, uint32_t *buckets)
+{
+    int count = 0;
+    unsigned char c0 = ' ', c1 = ' ';
+    for (const char *curr = name; ; curr++)
+    {
+        unsigned char c2 = *curr ? (unsigned char)*curr : ' ';
+        uint32_t hash = ((uint32_t)c0 << 16 | (uint32_t)c1 << 8 | c2) * 2654435761u;
+        uint32_t bucket = hash >> 16 & (NAME_INDEX_TRIGRAM_BUCKETS - 1);
+
+        bool found = false;
+        for (int i = 0; i < count && !found; i++)
+            found = buckets[i] == bucket;
+        if (!found)
+            buckets[count++] = bucket;
+
+        if (!*curr)
+            break;
+        c0 = c1;
+        c1 = c2;
+    }
+    return count;
+}
+
+/// @brief Construit l'index inversé des trigrammes des noms distincts.
+static void NameIndex_buildTrigrams(NameIndex *index)
+{
+    int bucketCount = NAME_INDEX_TRIGRAM_BUCKETS;
+    index->trigramOffsets = (int32_t *)calloc(bucketCount + 1, sizeof(int32_t));
+    index->trigramScores = (int32_t *)calloc(index->count > 0 ? index->count : 1, sizeof(int32_t));
+    index->trigramTouched = (int32_t *)calloc(index->count > 0 ? index->count : 1, sizeof(int32_t));
+    index->trigramCounts = (uint16_t *)calloc(index->count > 0 ? index->count : 1, sizeof(uint16_t));
+    AssertNew(index->trigramOffsets);
+    AssertNew(index->trigramScores);
+    AssertNew(index->trigramTouched);
+    AssertNew(index->trigramCounts);
+
+    size_t maxLength = 0;
+    for (int i = 0; i < index->count; i++)
+    {
+        size_t length = strlen(NameIndex_getName(index, i));
+        if (length > maxLength)
+            maxLength = length;
+    }
+    uint32_t *buckets = (uint32_t *)calloc(maxLength + 1, sizeof(uint32_t));
+    AssertNew(buckets);
+
+    // Deux passes : comptage puis remplissage des listes.
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int i = 0; i < index->count; i++)
+        {
+            if (i > 0 && index->nameOffsets[i - 1] == index->nameOffsets[i])
+                continue;
+
+            int count = NameIndex_getTrigrams(NameIndex_getName(index, i), buckets);
+            index->trigramCounts[i] = (uint16_t)(count < UINT16_MAX ? count : UINT16_MAX);
+            for (int j = 0; j < count; j++)
+            {
+                if (pass == 0)
+                    index->trigramOffsets[buckets[j] + 1]++;
+                else
+                    index->trigramPostings[index->trigramOffsets[buckets[j]]++] = i;
+            }
+        }
+
+        if (pass == 0)
+        {
+            for (int h = 0; h < bucketCount; h++)
+                index->trigramOffsets[h + 1] += index->trigramOffsets[h];
+            int postingCount = index->trigramOffsets[bucketCount];
+            index->trigramPostings = (int32_t *)calloc(postingCount > 0 ? postingCount : 1, sizeof(int32_t));
+            AssertNew(index->trigramPostings);
+        }
+        else
+        {
+            // Le remplissage a décalé chaque début de liste sur le suivant.
+            for (int h = bucketCount; h > 0; h--)
+                index->trigramOffsets[h] = index->trigramOffsets[h - 1];
+            index->trigramOffsets[0] = 0;
+        }
+    }
+    free(buckets);
+}
+
+/// @brief Calcule la distance de Levenshtein entre deux chaînes.
+/// @param a la première chaîne (la requête).
+/// @param b la seconde chaîne (le nom).
+/// @param[out] prefixDistance adresse où écrire la plus petite distance entre
+/// a et un préfixe de b.
+/// @return La distance entre a et b.
+static int NameIndex_editDistance(const char *a, const char *b, int *prefixDistance)
+{
+    int lengthA = (int)strlen(a);
+    int lengthB = (int)strlen(b);
+
+    int stackRow[64];
+    int *row = lengthB < 64 ? stackRow : (int *)calloc(lengthB + 1, sizeof(int));
+    AssertNew(row);
+
+    for (int j = 0; j <= lengthB; j++)
+        row[j] = j;
+    for (int i = 1; i <= lengthA; i++)
+    {
+        int diagonal = row[0];
+        row[0] = i;
+        for (int j = 1; j <= lengthB; j++)
+        {
+            int above = row[j];
+            int cost = diagonal + (a[i - 1] != b[j - 1]);
+            if (above + 1 < cost) cost = above + 1;
+            if (row[j - 1] + 1 < cost) cost = row[j - 1] + 1;
+            row[j] = cost;
+            diagonal = above;
+        }
+    }
+
+    int distance = row[lengthB];
+    *prefixDistance = distance;
+    for (int j = 0; j < lengthB; j++)
+    {
+        if (row[j] < *prefixDistance)
+            *prefixDistance = row[j];
+    }
+    if (row != stackRow)
+        free(row);
+    return distance;
+}
+
+/// @brief Candidat de NameIndex_search().
+typedef struct sNameCandidate
+{
+    /// @brief Position du premier homonyme.
+    int position;
+
+    /// @brief Similarité des trigrammes (indice de Jaccard).
+    float similarity;
+
+    /// @brief Distance d'édition entre la requête et le nom.
+    int distance;
+
+    /// @brief Distance d'édition entre la requête et le meilleur préfixe du nom.
+    int prefixDistance;
+} NameCandidate;
+
+/// @brief Compare deux candidats par distance au meilleur préfixe, distance,
+/// similarité puis position.
+int NameCandidate_compare(const void *a, const void *b)
+{
+    const NameCandidate *candA = (const NameCandidate *)a;
+    const NameCandidate *candB = (const NameCandidate *)b;
+    if (candA->prefixDistance != candB->prefixDistance)
+        return candA->prefixDistance - candB->prefixDistance;
+    if (candA->distance != candB->distance)
+        return candA->distance - candB->distance;
+    if (candA->similarity != candB->similarity)
+        return candA->similarity < candB->similarity ? 1 : -1;
+    return candA->position - candB->position;
+}
+
+int NameIndex_search(NameIndex *index, const char *query, int *positions, int maxCount)
+{
+    if (maxCount <= 0 || index->count <= 0)
+        return 0;
+    if (!index->trigramOffsets)
+        NameIndex_buildTrigrams(index);
+
+    char buffer[NAME_INDEX_QUERY_SIZE];
+    char *normalized = NameIndex_normalizeQuery(query, buffer);
+    uint32_t *buckets = (uint32_t *)calloc(strlen(normalized) + 1, sizeof(uint32_t));
+    AssertNew(buckets);
+    int queryCount = NameIndex_getTrigrams(normalized, buckets);
+
+    // Comptage des trigrammes communs. Les noms rencontrés sont mémorisés
+    // pour remettre les compteurs à zéro ensuite.
+    int32_t *scores = index->trigramScores;
+    int32_t *touched = index->trigramTouched;
+    int touchedCount = 0;
+    for (int i = 0; i < queryCount; i++)
+    {
+        const int32_t *postings = index->trigramPostings + index->trigramOffsets[buckets[i]];
+        const int32_t *postingsEnd = index->trigramPostings + index->trigramOffsets[buckets[i] + 1];
+        for (; postings < postingsEnd; postings++)
+        {
+            int position = *postings;
+            if (scores[position]++ == 0)
+                touched[touchedCount++] = position;
+        }
+    }
+
+    // Sélection des noms les plus similaires d'après leurs trigrammes.
+    NameCandidate candidates[NAME_INDEX_SEARCH_CANDIDATES];
+    int candidateCount = 0, minIdx = 0;
+    for (int i = 0; i < touchedCount; i++)
+    {
+        int position = touched[i];
+        int shared = scores[position];
+        scores[position] = 0;
+
+        // La similarité ne peut pas dépasser shared / queryCount : inutile
+        // de la calculer si cette borne n'atteint pas le pire candidat.
+        if (candidateCount == NAME_INDEX_SEARCH_CANDIDATES &&
+            shared <= candidates[minIdx].similarity * queryCount)
+            continue;
+
+        int nameCount = index->trigramCounts[position];
+        float similarity = (float)shared / (float)(queryCount + nameCount - shared);
+
+        if (candidateCount < NAME_INDEX_SEARCH_CANDIDATES)
+        {
+            candidates[candidateCount++] = (NameCandidate){ position, similarity, 0, 0 };
+        }
+        else if (similarity > candidates[minIdx].similarity)
+        {
+            candidates[minIdx] = (NameCandidate){ position, similarity, 0, 0 };
+        }
+        else continue;
+
+        // Mise à jour du candidat le moins similaire.
+        if (candidateCount == NAME_INDEX_SEARCH_CANDIDATES)
+        {
+            minIdx = 0;
+            for (int j = 1; j < candidateCount; j++)
+            {
+                if (candidates[j].similarity < candidates[minIdx].similarity)
+                    minIdx = j;
+            }
+        }
+    }
+    free(buckets);
+
+    // Classement par distance d'édition. Une requête incomplète ("CHALONS")
+    // est proche d'un préfixe du nom ("CHALONS EN CHAMPAGNE") ; les noms
+    // dont tous les préfixes diffèrent de plus de la moitié de la requête
+    // sont écartés.
+    int maxDistance = (int)strlen(normalized) / 2;
+    int keptCount = 0;
+    for (int i = 0; i < candidateCount; i++)
+    {
+        NameCandidate candidate = candidates[i];
+        candidate.distance = NameIndex_editDistance(
+            normalized, NameIndex_getName(index, candidate.position), &candidate.prefixDistance
+        );
+        if (candidate.prefixDistance <= maxDistance)
+            candidates[keptCount++] = candidate;
+    }
+    candidateCount = keptCount;
+    if (normalized != buffer)
+        free(normalized);
+    qsort(candidates, candidateCount, sizeof(NameCandidate), NameCandidate_compare);
+
+    // Les homonymes de chaque nom sont renvoyés ensemble.
+    int count = 0;
+    for (int i = 0; i < candidateCount && count < maxCount; i++)
+    {
+        int position = candidates[i].position;
+        do
+        {
+            positions[count++] = position++;
+        } while (count < maxCount && position < index->count &&
+            index->nameOffsets[position] == index->nameOffsets[position - 1]);
+    }
+    return count;
+}
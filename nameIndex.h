@@ -0,0 +1,165 @@
+#pragma once
+
+#include "settings.h"
+#include "municipalities.h"
+
+/// @brief Nombre de listes de l'index des trigrammes (puissance de 2).
+#define NAME_INDEX_TRIGRAM_BUCKETS (1 << 16)
+
+/// @brief Nombre de noms retenus d'après leurs trigrammes avant d'être
+/// classés par distance d'édition dans NameIndex_search().
+#define NAME_INDEX_SEARCH_CANDIDATES 64
+
+/// @brief Structure représentant un index des communes par nom.
+/// Les communes sont triées par nom normalisé puis par numéro INSEE : les
+/// homonymes sont contigus, tout comme les noms commençant par un même
+/// préfixe. Une table de hachage associe à chaque nom la position de son
+/// premier homonyme.
+/// Les tableaux peuvent appartenir à l'index ou désigner le contenu d'un
+/// instantané (voir NameIndex_createBorrowed()).
+typedef struct sNameIndex
+{
+    /// @brief Nombre de communes de l'index.
+    int count;
+
+    /// @brief Identifiants des communes, triés par nom normalisé puis par
+    /// numéro INSEE.
+    int32_t *ids;
+
+    /// @brief Position du nom normalisé de chaque commune dans names
+    /// (même ordre que ids).
+    int32_t *nameOffsets;
+
+    /// @brief Table des noms normalisés, terminés par '\0'.
+    char *names;
+
+    /// @brief Table de hachage à adressage ouvert des noms distincts.
+    /// Chaque case contient la position du premier homonyme, ou -1 si elle
+    /// est vide.
+    int32_t *slots;
+
+    /// @brief Nombre de cases de la table (puissance de 2).
+    int capacity;
+
+    /// @brief Tableau ID - Commune.
+    Municipalities **municipalities;
+
+    /// @brief true si les tableaux n'appartiennent pas à l'index.
+    bool borrowed;
+
+    /// @brief Index inversé des trigrammes au format CSR : les noms distincts
+    /// (position de leur premier homonyme) contenant un trigramme dont la
+    /// valeur de hachage est h sont trigramPostings[trigramOffsets[h]] à
+    /// trigramPostings[trigramOffsets[h + 1] - 1].
+    /// Il est construit lors du premier appel à NameIndex_search().
+    int32_t *trigramOffsets;
+    int32_t *trigramPostings;
+
+    /// @brief Nombre de trigrammes distincts de chaque nom, indexé par
+    /// position.
+    uint16_t *trigramCounts;
+
+    /// @brief Nombre de trigrammes communs avec la requête pour chaque
+    /// position, et positions rencontrées (tableaux de travail de
+    /// NameIndex_search()).
+    int32_t *trigramScores;
+    int32_t *trigramTouched;
+} NameIndex;
+
+/// @brief Crée l'index des noms d'un ensemble de communes.
+/// @param municipalities le tableau ID - Commune (les cases peuvent valoir NULL).
+/// @param count la taille du tableau.
+/// @return L'index créé.
+NameIndex *NameIndex_create(Municipalities **municipalities, int count);
+
+/// @brief Crée un index à partir de tableaux déjà construits (typiquement le
+/// contenu d'un instantané), sans les copier.
+/// Les tableaux doivent rester valides tant que l'index est utilisé.
+/// @param municipalities le tableau ID - Commune.
+/// @param count le nombre de communes de l'index.
+/// @param ids les identifiants triés des communes.
+/// @param nameOffsets les positions des noms normalisés.
+/// @param names la table des noms normalisés.
+/// @param slots la table de hachage.
+/// @param capacity le nombre de cases de la table de hachage.
+/// @return L'index créé.
+NameIndex *NameIndex_createBorrowed(
+    Municipalities **municipalities, int count,
+    int32_t *ids, int32_t *nameOffsets, char *names,
+    int32_t *slots, int capacity
+);
+
+/// @brief Détruit un index créé avec NameIndex_create() ou
+/// NameIndex_createBorrowed().
+/// Les communes ne sont pas détruites.
+/// @param index l'index.
+void NameIndex_destroy(NameIndex *index);
+
+/// @brief Normalise un nom de commune : translittération en ASCII, passage
+/// en majuscules et remplacement des tirets par des espaces.
+/// Par exemple "Châlons-en-Champagne" devient "CHALONS EN CHAMPAGNE".
+/// @param name le nom codé en UTF-8.
+/// @return Le nom normalisé, à libérer avec free().
+char *NameIndex_normalize(const char *name);
+
+/// @brief Renvoie la taille de la table des noms normalisés d'un index.
+/// @param index l'index.
+/// @return La taille en octets.
+size_t NameIndex_getNamesSize(NameIndex *index);
+
+/// @brief Renvoie le nom normalisé de la commune à une position de l'index.
+/// @param index l'index.
+/// @param position la position, entre 0 et index->count - 1.
+/// @return Le nom normalisé.
+INLINE const char *NameIndex_getName(NameIndex *index, int position)
+{
+    assert(position >= 0 && position < index->count);
+    return index->names + index->nameOffsets[position];
+}
+
+/// @brief Renvoie la commune à une position de l'index.
+/// @param index l'index.
+/// @param position la position, entre 0 et index->count - 1.
+/// @return La commune.
+INLINE Municipalities *NameIndex_getMunicipality(NameIndex *index, int position)
+{
+    assert(position >= 0 && position < index->count);
+    return index->municipalities[index->ids[position]];
+}
+
+/// @brief Cherche les communes portant un nom donné.
+/// Le nom est normalisé avant la recherche, qui s'effectue en temps constant.
+/// @param index l'index.
+/// @param name le nom recherché codé en UTF-8.
+/// @param[out] count adresse où écrire le nombre de communes trouvées.
+/// @return La position de la première commune portant ce nom (les suivantes
+/// sont contiguës et triées par numéro INSEE), -1 si aucune commune ne porte
+/// ce nom.
+int NameIndex_find(NameIndex *index, const char *name, int *count);
+
+/// @brief Cherche les premières communes dont le nom commence par un préfixe.
+/// Le préfixe est normalisé, puis les communes sont parcourues dans l'ordre
+/// de l'index (ordre alphabétique des noms normalisés).
+/// Cette méthode s'exécute en O(log n + maxCount).
+/// @param index l'index.
+/// @param prefix le préfixe codé en UTF-8.
+/// @param maxCount le nombre maximal de communes à renvoyer.
+/// @param[out] count adresse où écrire le nombre de communes trouvées.
+/// @return La position de la première commune trouvée (les suivantes sont
+/// contiguës), -1 si aucun nom ne commence par ce préfixe.
+int NameIndex_complete(NameIndex *index, const char *prefix, int maxCount, int *count);
+
+/// @brief Cherche les communes dont le nom ressemble le plus à une requête,
+/// par exemple mal orthographiée.
+/// Les noms partageant le plus de trigrammes avec la requête normalisée sont
+/// sélectionnés grâce à un index inversé, puis classés par distance d'édition
+/// (Levenshtein) croissante. Les homonymes sont renvoyés ensemble.
+/// L'index des trigrammes est construit au premier appel ; cette fonction ne
+/// doit pas être appelée par plusieurs threads en même temps.
+/// @param index l'index.
+/// @param query la requête codée en UTF-8.
+/// @param[out] positions tableau de maxCount cases où écrire les positions des
+/// communes trouvées, de la plus proche à la plus éloignée.
+/// @param maxCount le nombre maximal de communes à renvoyer.
+/// @return Le nombre de communes trouvées.
+int NameIndex_search(NameIndex *index, const char *query, int *positions, int maxCount);
@@ -0,0 +1,131 @@
+#include "nodeOrder.h"
+
+uint64_t NodeOrder_hilbertIndex(uint32_t x, uint32_t y)
+{
+    // À chaque niveau, le quadrant de la case donne deux bits de la position
+    // puis la case est ramenée dans l'orientation du sous-carré.
+    uint64_t index = 0;
+    for (uint32_t s = 1u << (NODE_ORDER_BITS - 1); s > 0; s >>= 1)
+    {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        index += (uint64_t)s * s * ((3 * rx) ^ ry);
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            uint32_t tmp = x;
+            x = y;
+            y = tmp;
+        }
+    }
+    return index;
+}
+
+/// @brief Noeud associé à sa position sur la courbe, utilisé pour le tri.
+typedef struct sNodeKey
+{
+    uint64_t key;
+    int id;
+} NodeKey;
+
+/// @brief Compare deux noeuds par position sur la courbe puis par identifiant.
+int NodeKey_compare(const void *a, const void *b)
+{
+    const NodeKey *nodeA = (const NodeKey *)a;
+    const NodeKey *nodeB = (const NodeKey *)b;
+    if (nodeA->key != nodeB->key)
+        return nodeA->key < nodeB->key ? -1 : 1;
+    return (nodeA->id > nodeB->id) - (nodeA->id < nodeB->id);
+}
+
+/// @brief Ramène une coordonnée dans [0, 2^NODE_ORDER_BITS[.
+INLINE uint32_t NodeOrder_scale(double value, double min, double max)
+{
+    uint32_t last = (1u << NODE_ORDER_BITS) - 1;
+    if (max <= min)
+        return 0;
+    double scaled = (value - min) / (max - min) * last;
+    return scaled <= 0.0 ? 0 : (scaled >= last ? last : (uint32_t)scaled);
+}
+
+NodeOrder *NodeOrder_createHilbert(const double *latitudes, const double *longitudes, int count)
+{
+    NodeOrder *order = (NodeOrder *)calloc(1, sizeof(NodeOrder));
+    AssertNew(order);
+    order->count = count;
+    order->newIds = (int *)calloc(count > 0 ? count : 1, sizeof(int));
+    order->oldIds = (int *)calloc(count > 0 ? count : 1, sizeof(int));
+    AssertNew(order->newIds);
+    AssertNew(order->oldIds);
+
+    // Rectangle englobant les noeuds dont la position est connue.
+    double minLat = INFINITY, maxLat = -INFINITY;
+    double minLon = INFINITY, maxLon = -INFINITY;
+    for (int i = 0; i < count; i++)
+    {
+        if (isnan(latitudes[i]) || isnan(longitudes[i]))
+            continue;
+        minLat = fmin(minLat, latitudes[i]);
+        maxLat = fmax(maxLat, latitudes[i]);
+        minLon = fmin(minLon, longitudes[i]);
+        maxLon = fmax(maxLon, longitudes[i]);
+    }
+
+    // Les noeuds sans position ont une clé supérieure à toutes les autres.
+    NodeKey *keys = (NodeKey *)calloc(count > 0 ? count : 1, sizeof(NodeKey));
+    AssertNew(keys);
+    for (int i = 0; i < count; i++)
+    {
+        keys[i].id = i;
+        if (isnan(latitudes[i]) || isnan(longitudes[i]))
+        {
+            keys[i].key = UINT64_MAX;
+            continue;
+        }
+        keys[i].key = NodeOrder_hilbertIndex(
+            NodeOrder_scale(longitudes[i], minLon, maxLon),
+            NodeOrder_scale(latitudes[i], minLat, maxLat)
+        );
+    }
+    qsort(keys, count, sizeof(NodeKey), NodeKey_compare);
+
+    for (int i = 0; i < count; i++)
+    {
+        order->oldIds[i] = keys[i].id;
+        order->newIds[keys[i].id] = i;
+    }
+    free(keys);
+
+    return order;
+}
+
+void NodeOrder_destroy(NodeOrder *order)
+{
+    if (!order) return;
+
+    free(order->newIds);
+    free(order->oldIds);
+    free(order);
+}
+
+Graph *NodeOrder_applyToGraph(const NodeOrder *order, Graph *graph)
+{
+    assert(order->count == Graph_size(graph));
+    Graph *res = Graph_create(order->count);
+
+    for (int u = 0; u < order->count; u++)
+    {
+        ArcIter iter;
+        Graph_getSuccessorIterator(graph, order->oldIds[u], &iter);
+        while (ArcIter_hasNext(&iter))
+        {
+            Arc *arc = ArcIter_next(&iter);
+            Graph_set(res, u, order->newIds[arc->target], arc->weight);
+        }
+    }
+    return res;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "settings.h"
+#include "graph.h"
+
+/// @brief Nombre de bits de chaque coordonnée de la grille de la courbe de
+/// Hilbert (la grille compte 2^NODE_ORDER_BITS cases de côté).
+#define NODE_ORDER_BITS 16
+
+/// @brief Structure représentant une renumérotation des noeuds d'un graphe.
+/// Les noeuds voisins dans l'espace reçoivent des identifiants proches : les
+/// tableaux indexés par identifiant (distances, prédécesseurs, tas de
+/// l'algorithme de Dijkstra...) sont alors parcourus avec moins de défauts de
+/// cache.
+/// Les deux tableaux sont des permutations inverses l'une de l'autre.
+typedef struct sNodeOrder
+{
+    /// @brief Nombre de noeuds.
+    int count;
+
+    /// @brief Nouvel identifiant de chaque noeud, indexé par l'ancien.
+    int *newIds;
+
+    /// @brief Ancien identifiant de chaque noeud, indexé par le nouveau.
+    int *oldIds;
+} NodeOrder;
+
+/// @brief Renvoie la position d'une case de la grille le long de la courbe de
+/// Hilbert.
+/// @param x l'abscisse de la case, inférieure à 2^NODE_ORDER_BITS.
+/// @param y l'ordonnée de la case, inférieure à 2^NODE_ORDER_BITS.
+/// @return La position de la case sur la courbe.
+uint64_t NodeOrder_hilbertIndex(uint32_t x, uint32_t y);
+
+/// @brief Crée la renumérotation des noeuds selon leur position sur une
+/// courbe de Hilbert parcourant le rectangle englobant leurs coordonnées.
+/// Les noeuds sans position (coordonnée NAN) sont placés à la fin, dans leur
+/// ordre initial.
+/// Cette méthode s'exécute en O(n log n).
+/// @param latitudes la latitude de chaque noeud.
+/// @param longitudes la longitude de chaque noeud.
+/// @param count le nombre de noeuds.
+/// @return La renumérotation créée.
+NodeOrder *NodeOrder_createHilbert(const double *latitudes, const double *longitudes, int count);
+
+/// @brief Détruit une renumérotation.
+/// @param order la renumérotation.
+void NodeOrder_destroy(NodeOrder *order);
+
+/// @brief Crée une copie d'un graphe dont les noeuds sont renumérotés.
+/// Les arcs sont ajoutés dans l'ordre des nouveaux identifiants.
+/// @param order la renumérotation (de même taille que le graphe).
+/// @param graph le graphe.
+/// @return Le graphe renuméroté, à détruire avec Graph_destroy().
+Graph *NodeOrder_applyToGraph(const NodeOrder *order, Graph *graph);
@@ -0,0 +1,210 @@
+#include "number.h"
+
+/// @brief Puissances de 10 représentables exactement par un double.
+static const double Number_exactPowers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// @brief Structure représentant l'écriture décimale d'un nombre.
+typedef struct sNumberDecimal
+{
+    /// @brief true si le nombre est négatif.
+    bool negative;
+
+    /// @brief Chiffres de la partie entière.
+    const char *intDigits;
+    int intCount;
+
+    /// @brief Chiffres de la partie décimale.
+    const char *fracDigits;
+    int fracCount;
+
+    /// @brief Exposant décimal explicite (après 'e' ou 'E').
+    int exponent;
+
+    /// @brief Nombre d'octets lus.
+    int length;
+} NumberDecimal;
+
+INLINE bool Number_isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+INLINE bool Number_isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/// @brief Découpe l'écriture décimale d'un nombre sans la convertir.
+/// @return true si la chaîne commence par un nombre, false sinon.
+static bool Number_scan(const char *str, int length, NumberDecimal *decimal)
+{
+    int i = 0;
+    while (i < length && Number_isSpace(str[i]))
+        i++;
+
+    decimal->negative = false;
+    if (i < length && (str[i] == '+' || str[i] == '-'))
+    {
+        decimal->negative = (str[i] == '-');
+        i++;
+    }
+
+    decimal->intDigits = str + i;
+    while (i < length && Number_isDigit(str[i]))
+        i++;
+    decimal->intCount = (int)(str + i - decimal->intDigits);
+
+    decimal->fracDigits = str + i;
+    decimal->fracCount = 0;
+    if (i < length && str[i] == '.')
+    {
+        i++;
+        decimal->fracDigits = str + i;
+        while (i < length && Number_isDigit(str[i]))
+            i++;
+        decimal->fracCount = (int)(str + i - decimal->fracDigits);
+    }
+
+    if (decimal->intCount == 0 && decimal->fracCount == 0)
+        return false;
+
+    // L'exposant n'est pris en compte que s'il contient au moins un chiffre.
+    decimal->exponent = 0;
+    if (i < length && (str[i] == 'e' || str[i] == 'E'))
+    {
+        int j = i + 1;
+        bool negative = false;
+        if (j < length && (str[j] == '+' || str[j] == '-'))
+        {
+            negative = (str[j] == '-');
+            j++;
+        }
+        if (j < length && Number_isDigit(str[j]))
+        {
+            int exponent = 0;
+            for (; j < length && Number_isDigit(str[j]); j++)
+            {
+                if (exponent < 100000)
+                    exponent = 10 * exponent + (str[j] - '0');
+            }
+            decimal->exponent = negative ? -exponent : exponent;
+            i = j;
+        }
+    }
+
+    decimal->length = i;
+    return true;
+}
+
+/// @brief Renvoie le chiffre d'indice index de la suite formée par la partie
+/// entière et la partie décimale d'un nombre, 0 au-delà.
+INLINE int Number_digitAt(const NumberDecimal *decimal, long long index)
+{
+    if (index < 0)
+        return 0;
+    if (index < decimal->intCount)
+        return decimal->intDigits[index] - '0';
+    index -= decimal->intCount;
+    if (index < decimal->fracCount)
+        return decimal->fracDigits[index] - '0';
+    return 0;
+}
+
+/// @brief Convertit un nombre avec strtod() après l'avoir copié dans un buffer.
+static double Number_parseSlow(const char *str, int length)
+{
+    char buffer[256];
+    char *copy = buffer;
+    if (length >= (int)sizeof(buffer))
+    {
+        // Écriture de plus de 255 caractères : cas exceptionnel.
+        copy = (char *)calloc(length + 1, sizeof(char));
+        AssertNew(copy);
+    }
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+
+    double value = strtod(copy, NULL);
+    if (copy != buffer)
+        free(copy);
+    return value;
+}
+
+double Number_parseDouble(const char *str, int length, int *end)
+{
+    NumberDecimal decimal;
+    if (!Number_scan(str, length, &decimal))
+    {
+        if (end) *end = 0;
+        return 0.0;
+    }
+    if (end) *end = decimal.length;
+
+    // On accumule les chiffres significatifs en ignorant les zéros initiaux.
+    uint64_t mantissa = 0;
+    int digitCount = 0;
+    int totalCount = decimal.intCount + decimal.fracCount;
+    int firstDigit = 0;
+    while (firstDigit < totalCount && Number_digitAt(&decimal, firstDigit) == 0)
+        firstDigit++;
+    for (int i = firstDigit; i < totalCount; i++)
+    {
+        if (++digitCount > 19)
+            break;
+        mantissa = 10 * mantissa + Number_digitAt(&decimal, i);
+    }
+
+    // Algorithme de Clinger : si la mantisse et la puissance de 10 sont
+    // exactes, une seule opération flottante donne l'arrondi correct.
+    int exponent = decimal.exponent - decimal.fracCount;
+    if (digitCount <= 19 && mantissa <= (UINT64_C(1) << 53) &&
+        exponent >= -22 && exponent <= 22)
+    {
+        double value = (double)mantissa;
+        if (exponent < 0)
+            value /= Number_exactPowers[-exponent];
+        else
+            value *= Number_exactPowers[exponent];
+        return decimal.negative ? -value : value;
+    }
+
+    return Number_parseSlow(str, decimal.length);
+}
+
+int64_t Number_parseFixed(const char *str, int length, int decimals, int *end)
+{
+    assert(decimals >= 0 && decimals <= NUMBER_MAX_DECIMALS);
+
+    NumberDecimal decimal;
+    if (!Number_scan(str, length, &decimal))
+    {
+        if (end) *end = 0;
+        return 0;
+    }
+    if (end) *end = decimal.length;
+
+    // La valeur cherchée est formée des chiffres précédant la position
+    // (intCount + exponent + decimals) ; le chiffre suivant donne l'arrondi.
+    long long stop = (long long)decimal.intCount + decimal.exponent + decimals;
+    long long start = 0;
+    long long digitCount = decimal.intCount + decimal.fracCount;
+    while (start < stop && start < digitCount && Number_digitAt(&decimal, start) == 0)
+        start++;
+    if (start >= digitCount)
+        return 0;
+    if (stop - start > 19)
+        return decimal.negative ? INT64_MIN : INT64_MAX;
+
+    uint64_t value = 0;
+    for (long long i = start; i < stop; i++)
+        value = 10 * value + Number_digitAt(&decimal, i);
+    if (Number_digitAt(&decimal, stop) >= 5)
+        value++;
+
+    if (decimal.negative)
+        return value > (uint64_t)INT64_MAX ? INT64_MIN : -(int64_t)value;
+    return value > (uint64_t)INT64_MAX ? INT64_MAX : (int64_t)value;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "settings.h"
+
+/// @brief Nombre maximal de décimales acceptées par Number_parseFixed().
+#define NUMBER_MAX_DECIMALS 18
+
+/// @brief Lit un nombre décimal au début d'une chaîne de caractères ASCII ou
+/// UTF-8, qui n'a pas besoin d'être terminée par '\0'.
+/// Les espaces initiaux sont ignorés. Le résultat est l'arrondi correct de la
+/// valeur écrite, comme avec strtod() (indépendamment de la locale).
+/// Les nombres d'au plus 19 chiffres significatifs dont l'exposant décimal est
+/// compris entre -22 et 22 (ce qui couvre toutes les coordonnées GPS) sont
+/// convertis sans appel à la bibliothèque C ni allocation.
+/// @param str la chaîne.
+/// @param length la taille de la chaîne en octets.
+/// @param[out] end adresse où écrire le nombre d'octets lus (0 si la chaîne ne
+/// commence pas par un nombre). Peut valoir NULL.
+/// @return La valeur lue ou 0.0 si la chaîne ne commence pas par un nombre.
+double Number_parseDouble(const char *str, int length, int *end);
+
+/// @brief Lit un nombre décimal en virgule fixe au début d'une chaîne de
+/// caractères ASCII ou UTF-8, qui n'a pas besoin d'être terminée par '\0'.
+/// La valeur renvoyée est le nombre multiplié par 10^decimals, arrondi au plus
+/// proche (à l'opposé de zéro en cas d'égalité). Par exemple "45.4338889"
+/// avec 6 décimales donne 45433889. Le calcul est exact et n'utilise pas de
+/// nombres flottants.
+/// @param str la chaîne.
+/// @param length la taille de la chaîne en octets.
+/// @param decimals le nombre de décimales, entre 0 et NUMBER_MAX_DECIMALS.
+/// @param[out] end adresse où écrire le nombre d'octets lus (0 si la chaîne ne
+/// commence pas par un nombre). Peut valoir NULL.
+/// @return La valeur lue, saturée à INT64_MIN ou INT64_MAX en cas de
+/// dépassement, 0 si la chaîne ne commence pas par un nombre.
+int64_t Number_parseFixed(const char *str, int length, int decimals, int *end);
@@ -15,6 +15,12 @@
 
 #define MAX_MUNICIPALITIES 50000
 
+/// @brief Nombre maximal de threads utilisés pour parser un fichier.
+#define MAX_PARSE_THREADS 64
+
+/// @brief Taille minimale en octets d'un morceau de fichier parsé par un thread.
+#define MIN_PARSE_CHUNK_SIZE (1 << 20)
+
 #define AssertNew(ptr) { if (ptr == NULL) { assert(false); abort(); } }
 
 #ifdef _WIN32
@@ -0,0 +1,374 @@
+#include "snapshot.h"
+#include "mappedFile.h"
+
+#define SNAPSHOT_MAGIC "POTOOSNP"
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+
+/// @brief En-tête d'un fichier d'instantané.
+/// Les positions des sections sont données en octets depuis le début du
+/// fichier et sont alignées sur 8 octets.
+typedef struct sSnapshotHeader
+{
+    /// @brief Signature du fichier (SNAPSHOT_MAGIC).
+    char magic[8];
+
+    /// @brief Version du format (SNAPSHOT_VERSION).
+    uint32_t version;
+
+    /// @brief Vaut SNAPSHOT_BYTE_ORDER si le fichier a été écrit avec le même
+    /// ordre des octets que la machine courante.
+    uint32_t byteOrder;
+
+    /// @brief Taille totale du fichier.
+    uint64_t fileSize;
+
+    /// @brief Somme de contrôle FNV-1a de tout ce qui suit l'en-tête.
+    uint64_t checksum;
+
+    /// @brief Nombre de noeuds et d'arcs du graphe.
+    int32_t nodeCount;
+    int32_t arcCount;
+
+    /// @brief Positions des sections.
+    uint64_t municipalitiesOffset;
+    uint64_t offsetsOffset;
+    uint64_t targetsOffset;
+    uint64_t weightsOffset;
+    uint64_t stringsOffset;
+
+    /// @brief Taille de la table des chaînes.
+    uint64_t stringsSize;
+
+    /// @brief Nombre de communes de l'index des noms et nombre de cases de
+    /// sa table de hachage.
+    int32_t nameCount;
+    int32_t nameCapacity;
+
+    /// @brief Positions des sections de l'index des noms.
+    uint64_t nameIdsOffset;
+    uint64_t nameOffsetsOffset;
+    uint64_t nameSlotsOffset;
+    uint64_t namesOffset;
+
+    /// @brief Taille de la table des noms normalisés.
+    uint64_t namesSize;
+} SnapshotHeader;
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ull
+#define FNV_PRIME 0x100000001b3ull
+
+/// @brief Met à jour une somme de contrôle FNV-1a avec un bloc de données.
+uint64_t Snapshot_checksum(uint64_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/// @brief Écrit une section dans le fichier et la complète par des zéros
+/// jusqu'au prochain multiple de 8 octets.
+/// @param output le fichier.
+/// @param data les données de la section.
+/// @param size la taille de la section.
+/// @param checksum la somme de contrôle à mettre à jour.
+/// @param offset la position courante dans le fichier, mise à jour.
+/// @return La position de la section dans le fichier, 0 en cas d'erreur.
+uint64_t Snapshot_writeSection(
+    FILE *output, const void *data, size_t size,
+    uint64_t *checksum, uint64_t *offset)
+{
+    static const char padding[8] = { 0 };
+    uint64_t start = *offset;
+    size_t padSize = (8 - size % 8) % 8;
+
+    if (size > 0 && fwrite(data, 1, size, output) != size)
+        return 0;
+    if (padSize > 0 && fwrite(padding, 1, padSize, output) != padSize)
+        return 0;
+
+    *checksum = Snapshot_checksum(*checksum, data, size);
+    *checksum = Snapshot_checksum(*checksum, padding, padSize);
+    *offset += size + padSize;
+    return start;
+}
+
+bool Snapshot_write(
+    const char *filename, Graph *graph,
+    Municipalities **municipalities, int *barCounts, NameIndex *nameIndex)
+{
+    int nodeCount = Graph_size(graph);
+
+    // Construction des tableaux CSR du graphe.
+    int *offsets = (int *)calloc(nodeCount + 1, sizeof(int));
+    AssertNew(offsets);
+    for (int u = 0; u < nodeCount; u++)
+    {
+        offsets[u + 1] = offsets[u] + Graph_getPositiveValency(graph, u);
+    }
+    int arcCount = offsets[nodeCount];
+    int *targets = (int *)calloc(arcCount > 0 ? arcCount : 1, sizeof(int));
+    float *weights = (float *)calloc(arcCount > 0 ? arcCount : 1, sizeof(float));
+    AssertNew(targets);
+    AssertNew(weights);
+    for (int u = 0; u < nodeCount; u++)
+    {
+        ArcIter iter;
+        int idx = offsets[u];
+        Graph_getSuccessorIterator(graph, u, &iter);
+        while (ArcIter_hasNext(&iter))
+        {
+            Arc *arc = ArcIter_next(&iter);
+            targets[idx] = arc->target;
+            weights[idx] = arc->weight;
+            idx++;
+        }
+    }
+
+    // Table des communes et table des chaînes.
+    SnapshotMunicipality *records =
+        (SnapshotMunicipality *)calloc(nodeCount, sizeof(SnapshotMunicipality));
+    AssertNew(records);
+    size_t stringsSize = 0;
+    for (int u = 0; u < nodeCount; u++)
+    {
+        if (municipalities[u])
+            stringsSize += strlen(municipalities[u]->nom_commune_postal) + 1;
+    }
+    char *strings = (char *)calloc(stringsSize > 0 ? stringsSize : 1, sizeof(char));
+    AssertNew(strings);
+    size_t stringsIdx = 0;
+    for (int u = 0; u < nodeCount; u++)
+    {
+        Municipalities *municipality = municipalities[u];
+        SnapshotMunicipality *record = &records[u];
+        record->nameOffset = -1;
+        if (!municipality)
+            continue;
+
+        size_t nameSize = strlen(municipality->nom_commune_postal) + 1;
+        Memcpy(
+            strings + stringsIdx, nameSize,
+            municipality->nom_commune_postal, nameSize
+        );
+        record->nameOffset = (int32_t)stringsIdx;
+        stringsIdx += nameSize;
+
+        strncpy(record->code, municipality->code_commune_INSEE, sizeof(record->code) - 1);
+        record->latitude = municipality->latitude;
+        record->longitude = municipality->longitude;
+        record->barCount = barCounts ? barCounts[u] : 0;
+    }
+
+    bool success = false;
+    FILE *output = fopen(filename, "wb");
+    if (output)
+    {
+        SnapshotHeader header = { 0 };
+        Memcpy(header.magic, sizeof(header.magic), SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.byteOrder = SNAPSHOT_BYTE_ORDER;
+        header.nodeCount = nodeCount;
+        header.arcCount = arcCount;
+        header.stringsSize = stringsSize;
+        header.nameCount = nameIndex->count;
+        header.nameCapacity = nameIndex->capacity;
+        header.namesSize = NameIndex_getNamesSize(nameIndex);
+
+        // L'en-tête est écrit une première fois pour réserver sa place, puis
+        // réécrit une fois les positions et la somme de contrôle connues.
+        uint64_t checksum = FNV_OFFSET_BASIS;
+        uint64_t offset = sizeof(SnapshotHeader);
+        success = fwrite(&header, sizeof(header), 1, output) == 1;
+
+        header.municipalitiesOffset = Snapshot_writeSection(
+            output, records, nodeCount * sizeof(SnapshotMunicipality), &checksum, &offset);
+        header.offsetsOffset = Snapshot_writeSection(
+            output, offsets, (nodeCount + 1) * sizeof(int), &checksum, &offset);
+        header.targetsOffset = Snapshot_writeSection(
+            output, targets, arcCount * sizeof(int), &checksum, &offset);
+        header.weightsOffset = Snapshot_writeSection(
+            output, weights, arcCount * sizeof(float), &checksum, &offset);
+        header.stringsOffset = Snapshot_writeSection(
+            output, strings, stringsSize, &checksum, &offset);
+        header.nameIdsOffset = Snapshot_writeSection(
+            output, nameIndex->ids, nameIndex->count * sizeof(int32_t), &checksum, &offset);
+        header.nameOffsetsOffset = Snapshot_writeSection(
+            output, nameIndex->nameOffsets, nameIndex->count * sizeof(int32_t), &checksum, &offset);
+        header.nameSlotsOffset = Snapshot_writeSection(
+            output, nameIndex->slots, nameIndex->capacity * sizeof(int32_t), &checksum, &offset);
+        header.namesOffset = Snapshot_writeSection(
+            output, nameIndex->names, header.namesSize, &checksum, &offset);
+
+        success = success &&
+            header.municipalitiesOffset && header.offsetsOffset &&
+            header.targetsOffset && header.weightsOffset && header.stringsOffset &&
+            header.nameIdsOffset && header.nameOffsetsOffset &&
+            header.nameSlotsOffset && header.namesOffset;
+
+        header.fileSize = offset;
+        header.checksum = checksum;
+        success = success &&
+            fseek(output, 0, SEEK_SET) == 0 &&
+            fwrite(&header, sizeof(header), 1, output) == 1;
+        success = (fclose(output) == 0) && success;
+    }
+
+    free(offsets);
+    free(targets);
+    free(weights);
+    free(records);
+    free(strings);
+
+    return success;
+}
+
+/// @brief Vérifie qu'une section est contenue dans le fichier.
+INLINE bool Snapshot_checkSection(const SnapshotHeader *header, uint64_t offset, uint64_t size)
+{
+    return offset >= sizeof(SnapshotHeader) && offset % 8 == 0 &&
+        offset <= header->fileSize && size <= header->fileSize - offset;
+}
+
+/// @brief Vérifie l'en-tête et le contenu d'un fichier projeté en mémoire.
+bool Snapshot_check(const void *data, size_t size)
+{
+    if (size < sizeof(SnapshotHeader))
+        return false;
+
+    const SnapshotHeader *header = data;
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != SNAPSHOT_VERSION ||
+        header->byteOrder != SNAPSHOT_BYTE_ORDER ||
+        header->fileSize != size ||
+        header->nodeCount < 1 || header->arcCount < 0)
+        return false;
+
+    uint64_t nodeCount = header->nodeCount, arcCount = header->arcCount;
+    if (!Snapshot_checkSection(header, header->municipalitiesOffset,
+                               nodeCount * sizeof(SnapshotMunicipality)) ||
+        !Snapshot_checkSection(header, header->offsetsOffset, (nodeCount + 1) * sizeof(int)) ||
+        !Snapshot_checkSection(header, header->targetsOffset, arcCount * sizeof(int)) ||
+        !Snapshot_checkSection(header, header->weightsOffset, arcCount * sizeof(float)) ||
+        !Snapshot_checkSection(header, header->stringsOffset, header->stringsSize))
+        return false;
+
+    uint64_t nameCount = header->nameCount, nameCapacity = header->nameCapacity;
+    if (header->nameCount < 0 || nameCount > nodeCount ||
+        header->nameCapacity <= (int32_t)nameCount ||
+        (nameCapacity & (nameCapacity - 1)) != 0 ||
+        !Snapshot_checkSection(header, header->nameIdsOffset, nameCount * sizeof(int32_t)) ||
+        !Snapshot_checkSection(header, header->nameOffsetsOffset, nameCount * sizeof(int32_t)) ||
+        !Snapshot_checkSection(header, header->nameSlotsOffset, nameCapacity * sizeof(int32_t)) ||
+        !Snapshot_checkSection(header, header->namesOffset, header->namesSize))
+        return false;
+
+    const unsigned char *bytes = data;
+    uint64_t checksum = Snapshot_checksum(
+        FNV_OFFSET_BASIS, bytes + sizeof(SnapshotHeader), size - sizeof(SnapshotHeader)
+    );
+    if (checksum != header->checksum)
+        return false;
+
+    // Les tableaux CSR doivent décrire un graphe valide.
+    const int *offsets = (const int *)(bytes + header->offsetsOffset);
+    const int *targets = (const int *)(bytes + header->targetsOffset);
+    if (offsets[0] != 0 || offsets[nodeCount] != header->arcCount)
+        return false;
+    for (uint64_t u = 0; u < nodeCount; u++)
+    {
+        if (offsets[u] > offsets[u + 1])
+            return false;
+    }
+    for (uint64_t i = 0; i < arcCount; i++)
+    {
+        if (targets[i] < 0 || targets[i] >= header->nodeCount)
+            return false;
+    }
+
+    // Les chaînes doivent être terminées par '\0' dans leur table.
+    const SnapshotMunicipality *records =
+        (const SnapshotMunicipality *)(bytes + header->municipalitiesOffset);
+    const char *strings = (const char *)(bytes + header->stringsOffset);
+    if (header->stringsSize > 0 && strings[header->stringsSize - 1] != '\0')
+        return false;
+    for (uint64_t u = 0; u < nodeCount; u++)
+    {
+        if (records[u].code[sizeof(records[u].code) - 1] != '\0' ||
+            records[u].nameOffset < -1 ||
+            (records[u].nameOffset >= 0 && (uint64_t)records[u].nameOffset >= header->stringsSize))
+            return false;
+    }
+
+    // L'index des noms ne doit désigner que des communes et des noms
+    // existants, et sa table de hachage doit contenir une case vide.
+    const int32_t *nameIds = (const int32_t *)(bytes + header->nameIdsOffset);
+    const int32_t *nameOffsets = (const int32_t *)(bytes + header->nameOffsetsOffset);
+    const int32_t *nameSlots = (const int32_t *)(bytes + header->nameSlotsOffset);
+    const char *names = (const char *)(bytes + header->namesOffset);
+    if (header->namesSize > 0 && names[header->namesSize - 1] != '\0')
+        return false;
+    for (uint64_t i = 0; i < nameCount; i++)
+    {
+        if (nameIds[i] < 0 || nameIds[i] >= header->nodeCount ||
+            records[nameIds[i]].nameOffset < 0 ||
+            nameOffsets[i] < 0 || (uint64_t)nameOffsets[i] >= header->namesSize)
+            return false;
+    }
+    uint64_t usedSlots = 0;
+    for (uint64_t i = 0; i < nameCapacity; i++)
+    {
+        if (nameSlots[i] < -1 || nameSlots[i] >= header->nameCount)
+            return false;
+        usedSlots += nameSlots[i] >= 0;
+    }
+    return usedSlots < nameCapacity;
+}
+
+Snapshot *Snapshot_open(const char *filename)
+{
+    void *data = NULL;
+    size_t size = 0;
+    if (!MappedFile_open(filename, &data, &size) || !data)
+        return NULL;
+
+    Snapshot *snapshot = (Snapshot *)calloc(1, sizeof(Snapshot));
+    AssertNew(snapshot);
+    snapshot->data = data;
+    snapshot->size = size;
+
+    if (!Snapshot_check(data, size))
+    {
+        Snapshot_close(snapshot);
+        return NULL;
+    }
+
+    const SnapshotHeader *header = data;
+    char *bytes = data;
+    snapshot->nodeCount = header->nodeCount;
+    snapshot->arcCount = header->arcCount;
+    snapshot->municipalities = (SnapshotMunicipality *)(bytes + header->municipalitiesOffset);
+    snapshot->offsets = (int *)(bytes + header->offsetsOffset);
+    snapshot->targets = (int *)(bytes + header->targetsOffset);
+    snapshot->weights = (float *)(bytes + header->weightsOffset);
+    snapshot->strings = bytes + header->stringsOffset;
+    snapshot->nameCount = header->nameCount;
+    snapshot->nameCapacity = header->nameCapacity;
+    snapshot->nameIds = (int32_t *)(bytes + header->nameIdsOffset);
+    snapshot->nameOffsets = (int32_t *)(bytes + header->nameOffsetsOffset);
+    snapshot->nameSlots = (int32_t *)(bytes + header->nameSlotsOffset);
+    snapshot->names = bytes + header->namesOffset;
+
+    return snapshot;
+}
+
+void Snapshot_close(Snapshot *snapshot)
+{
+    if (!snapshot) return;
+
+    MappedFile_close(snapshot->data, snapshot->size);
+    free(snapshot);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "settings.h"
+#include "graph.h"
+#include "municipalities.h"
+#include "nameIndex.h"
+
+/// @brief Version du format des fichiers d'instantané.
+/// Elle doit être incrémentée à chaque modification de la disposition du
+/// fichier.
+#define SNAPSHOT_VERSION 2
+
+/// @brief Structure représentant une commune dans un instantané.
+/// Les enregistrements sont indexés par l'identifiant de noeud de la commune.
+typedef struct sSnapshotMunicipality
+{
+    /// @brief Latitude de la commune.
+    double latitude;
+
+    /// @brief Longitude de la commune.
+    double longitude;
+
+    /// @brief Position du nom de la commune dans la table des chaînes,
+    /// -1 si aucune commune n'est associée à cet identifiant.
+    int32_t nameOffset;
+
+    /// @brief Nombre de bars à proximité de la commune.
+    int32_t barCount;
+
+    /// @brief Numéro INSEE de la commune, terminé par '\0'.
+    char code[8];
+} SnapshotMunicipality;
+
+/// @brief Structure représentant un instantané ouvert avec Snapshot_open().
+/// Tous les pointeurs désignent directement le contenu du fichier projeté en
+/// mémoire (en lecture seule), qui peut ainsi être partagé par plusieurs
+/// processus.
+typedef struct sSnapshot
+{
+    /// @brief Début du fichier projeté en mémoire.
+    void *data;
+
+    /// @brief Taille du fichier en octets.
+    size_t size;
+
+    /// @brief Nombre de noeuds du graphe.
+    int nodeCount;
+
+    /// @brief Nombre d'arcs du graphe.
+    int arcCount;
+
+    /// @brief Tableau des communes, indexé par identifiant de noeud.
+    SnapshotMunicipality *municipalities;
+
+    /// @brief Tableaux CSR du graphe pondéré (voir Graph_createCsr()).
+    int *offsets;
+    int *targets;
+    float *weights;
+
+    /// @brief Table des chaînes de caractères (noms des communes).
+    char *strings;
+
+    /// @brief Index des noms des communes (voir NameIndex_createBorrowed()).
+    int nameCount;
+    int nameCapacity;
+    int32_t *nameIds;
+    int32_t *nameOffsets;
+    int32_t *nameSlots;
+    char *names;
+} Snapshot;
+
+/// @brief Écrit un instantané du graphe préparé dans un fichier.
+/// Le fichier contient un en-tête versionné, la table des communes (avec leur
+/// nombre de bars), le graphe pondéré au format CSR, l'index des noms et une
+/// somme de contrôle.
+/// Il utilise l'ordre des octets de la machine.
+/// @param filename chemin du fichier.
+/// @param graph le graphe pondéré.
+/// @param municipalities le tableau ID - Commune (les cases peuvent valoir NULL).
+/// @param barCounts le nombre de bars de chaque commune.
+/// @param nameIndex l'index des noms des communes.
+/// @return true si l'écriture a réussi, false sinon.
+bool Snapshot_write(
+    const char *filename, Graph *graph,
+    Municipalities **municipalities, int *barCounts, NameIndex *nameIndex
+);
+
+/// @brief Ouvre un instantané écrit avec Snapshot_write().
+/// Le fichier est projeté en mémoire puis son en-tête et sa somme de contrôle
+/// sont vérifiés.
+/// @param filename chemin du fichier.
+/// @return L'instantané ouvert ou NULL si le fichier est invalide.
+Snapshot *Snapshot_open(const char *filename);
+
+/// @brief Ferme un instantané ouvert avec Snapshot_open().
+/// Les pointeurs vers son contenu ne sont plus valides après l'appel.
+/// @param snapshot l'instantané.
+void Snapshot_close(Snapshot *snapshot);
@@ -3,11 +3,193 @@
 #endif
 
 #include "uniStr.h"
+#include "number.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 
+/// @brief Nombre maximal de caractères lus par les fonctions UniStr_get*().
+#define UNISTR_NUMBER_MAX_LEN 64
+
+// Les suites de caractères ASCII sont traitées par blocs avec les
+// instructions SSE2 (toujours présentes en x86-64) ou AVX2 (si le processeur
+// les supporte, vérifié à l'exécution). Les autres caractères sont traités
+// un par un.
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(_UNISTR_SCALAR)
+#define UNISTR_SIMD
+#include <immintrin.h>
+#endif
+
+/// @brief Renvoie le nombre de caractères ASCII non nuls au début d'un buffer
+/// (version sans instruction vectorielle).
+INLINE int UniStr_asciiSpanScalar(const char *buffer, int size)
+{
+    int i = 0;
+    while (i < size && (unsigned char)buffer[i] - 1u < 0x7Fu)
+        i++;
+    return i;
+}
+
+/// @brief Copie les caractères ASCII au début d'un buffer UTF8 valide dans
+/// un tableau de caractères UTF32 et renvoie leur nombre
+/// (version sans instruction vectorielle).
+INLINE int UniStr_widenAsciiScalar(const char *buffer, char32 *data, int count)
+{
+    int i = 0;
+    while (i < count && (unsigned char)buffer[i] < 0x80)
+    {
+        data[i] = (unsigned char)buffer[i];
+        i++;
+    }
+    return i;
+}
+
+#ifdef UNISTR_SIMD
+
+// Les fonctions AVX2 n'appellent pas les fonctions SSE2 : les blocs de 16
+// octets y sont traités par les fonctions INLINE ci-dessous, compilées avec
+// le jeu d'instructions de l'appelant. Mélanger les deux encodages
+// ralentit fortement certains processeurs.
+
+/// @brief Renvoie le masque des octets non ASCII ou nuls d'un bloc de 16
+/// octets.
+INLINE int UniStr_asciiMask16(const char *buffer)
+{
+    __m128i block = _mm_loadu_si128((const __m128i *)buffer);
+    return _mm_movemask_epi8(_mm_or_si128(block, _mm_cmpeq_epi8(block, _mm_setzero_si128())));
+}
+
+/// @brief Convertit un bloc de 16 octets en caractères UTF32 et renvoie le
+/// masque de ses octets non ASCII.
+INLINE int UniStr_widen16(const char *buffer, char32 *data)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i block = _mm_loadu_si128((const __m128i *)buffer);
+    __m128i low = _mm_unpacklo_epi8(block, zero);
+    __m128i high = _mm_unpackhi_epi8(block, zero);
+    _mm_storeu_si128((__m128i *)data, _mm_unpacklo_epi16(low, zero));
+    _mm_storeu_si128((__m128i *)(data + 4), _mm_unpackhi_epi16(low, zero));
+    _mm_storeu_si128((__m128i *)(data + 8), _mm_unpacklo_epi16(high, zero));
+    _mm_storeu_si128((__m128i *)(data + 12), _mm_unpackhi_epi16(high, zero));
+    return _mm_movemask_epi8(block);
+}
+
+/// @brief Version SSE2 de UniStr_asciiSpan().
+static int UniStr_asciiSpanSse2(const char *buffer, int size)
+{
+    int i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        // Le bit de poids fort est à 1 pour les octets non ASCII et nuls.
+        int mask = UniStr_asciiMask16(buffer + i);
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    return i + UniStr_asciiSpanScalar(buffer + i, size - i);
+}
+
+/// @brief Version AVX2 de UniStr_asciiSpan().
+__attribute__((target("avx2")))
+static int UniStr_asciiSpanAvx2(const char *buffer, int size)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(buffer + i));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(
+            _mm256_or_si256(block, _mm256_cmpeq_epi8(block, zero)));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    if (i + 16 <= size)
+    {
+        int mask = UniStr_asciiMask16(buffer + i);
+        if (mask)
+            return i + __builtin_ctz(mask);
+        i += 16;
+    }
+    return i + UniStr_asciiSpanScalar(buffer + i, size - i);
+}
+
+/// @brief Version SSE2 de UniStr_widenAscii().
+/// Chaque bloc de 16 octets est converti entièrement : les cases qui suivent
+/// le premier caractère non ASCII sont réécrites ensuite.
+static int UniStr_widenAsciiSse2(const char *buffer, char32 *data, int count)
+{
+    int i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        int mask = UniStr_widen16(buffer + i, data + i);
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    return i + UniStr_widenAsciiScalar(buffer + i, data + i, count - i);
+}
+
+/// @brief Version AVX2 de UniStr_widenAscii().
+__attribute__((target("avx2")))
+static int UniStr_widenAsciiAvx2(const char *buffer, char32 *data, int count)
+{
+    int i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(buffer + i));
+        __m128i low = _mm256_castsi256_si128(block);
+        __m128i high = _mm256_extracti128_si256(block, 1);
+        _mm256_storeu_si256((__m256i *)(data + i), _mm256_cvtepu8_epi32(low));
+        _mm256_storeu_si256((__m256i *)(data + i + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+        _mm256_storeu_si256((__m256i *)(data + i + 16), _mm256_cvtepu8_epi32(high));
+        _mm256_storeu_si256((__m256i *)(data + i + 24), _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(block);
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    if (i + 16 <= count)
+    {
+        int mask = UniStr_widen16(buffer + i, data + i);
+        if (mask)
+            return i + __builtin_ctz(mask);
+        i += 16;
+    }
+    return i + UniStr_widenAsciiScalar(buffer + i, data + i, count - i);
+}
+
+#endif
+
+/// @brief Renvoie le nombre de caractères ASCII non nuls au début d'un buffer.
+/// @param buffer le buffer.
+/// @param size la taille du buffer en octets.
+INLINE int UniStr_asciiSpan(const char *buffer, int size)
+{
+#ifdef UNISTR_SIMD
+    if (__builtin_cpu_supports("avx2"))
+        return UniStr_asciiSpanAvx2(buffer, size);
+    return UniStr_asciiSpanSse2(buffer, size);
+#else
+    return UniStr_asciiSpanScalar(buffer, size);
+#endif
+}
+
+/// @brief Copie les caractères ASCII au début d'un buffer UTF8 valide dans
+/// un tableau de caractères UTF32.
+/// @param buffer le buffer, qui contient au moins count caractères.
+/// @param data le tableau de destination, de taille au moins count.
+/// @param count le nombre maximal de caractères à copier.
+/// @return Le nombre de caractères ASCII copiés.
+INLINE int UniStr_widenAscii(const char *buffer, char32 *data, int count)
+{
+#ifdef UNISTR_SIMD
+    if (__builtin_cpu_supports("avx2"))
+        return UniStr_widenAsciiAvx2(buffer, data, count);
+    return UniStr_widenAsciiSse2(buffer, data, count);
+#else
+    return UniStr_widenAsciiScalar(buffer, data, count);
+#endif
+}
+
 // +----------------+----------+----------+----------+----------+
 // | Valeur         | Octet 1  | Octet 2  | Octet 3  | Octet 4  |
 // +----------------+----------+----------+----------+----------+
@@ -27,6 +209,14 @@ int getSizeU8To32(const char *bufferU8, int bufferSize)
     int i = 0;
     while ((i < bufferSize) && (bufferU8[i] != '\0'))
     {
+        // Suite de caractères ASCII
+        int span = UniStr_asciiSpan(bufferU8 + i, bufferSize - i);
+        if (span > 0)
+        {
+            i += span; sizeU32 += span;
+            continue;
+        }
+
         char c = bufferU8[i];
         if ((c & 0x80) == 0x00)
         {
@@ -137,11 +327,19 @@ char *encodeUTF8(char *text, char32 cp)
 }
 #undef EMIT
 
+/// @brief Renvoie la taille d'un buffer terminé par '\0', '\0' compris.
+INLINE int UniStr_getBufferSize(const char *buffer)
+{
+    size_t length = strlen(buffer);
+    return length < INT_MAX ? (int)length + 1 : INT_MAX;
+}
+
 UniStr *UniStr_decodeU8(char *bufferU8, int bufferSize)
 {
     if (bufferSize < 0)
     {
-        bufferSize = INT_MAX;
+        // Les blocs lus par getSizeU8To32() ne dépassent pas la fin du buffer.
+        bufferSize = UniStr_getBufferSize(bufferU8);
     }
 
     int sizeU32 = getSizeU8To32(bufferU8, bufferSize);
@@ -160,8 +358,17 @@ UniStr *UniStr_decodeU8(char *bufferU8, int bufferSize)
         data = (char32 *)calloc(sizeU32, sizeof(char32));
         AssertNew(data);
 
-        for (int i = 0; i < sizeU32; i++)
-            bufferU8 = decodeUTF8(bufferU8, data + i);
+        int i = 0;
+        while (i < sizeU32)
+        {
+            int span = UniStr_widenAscii(bufferU8, data + i, sizeU32 - i);
+            bufferU8 += span; i += span;
+            if (i < sizeU32)
+            {
+                bufferU8 = decodeUTF8(bufferU8, data + i);
+                i++;
+            }
+        }
     }
 
     string->data = data;
@@ -174,7 +381,7 @@ UniStr *UniStr_decodeAscii(char *bufferAscii, int bufferSize)
 {
     if (bufferSize < 0)
     {
-        bufferSize = INT_MAX;
+        bufferSize = UniStr_getBufferSize(bufferAscii);
     }
 
     int sizeU32 = getSizeU8To32(bufferAscii, bufferSize);
@@ -257,179 +464,161 @@ char *UniStr_encodeU8(UniStr *string)
     return bufferU8;
 }
 
-//         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-// ------------------------------------------------------
-// U+00C0  À  Á  Â  Ã  Ä  Å  Æ  Ç  È  É  Ê  Ë  Ì  Í  Î  Ï
-// U+00D0  Ð  Ñ  Ò  Ó  Ô  Õ  Ö  ×  Ø  Ù  Ú  Û  Ü  Ý  Þ  ß
-// U+00E0  à  á  â  ã  ä  å  æ  ç  è  é  ê  ë  ì  í  î  ï
-// U+00F0  ð  ñ  ò  ó  ô  õ  ö  ÷  ø  ù  ú  û  ü  ý  þ  ÿ
-// 
-// U+0150  Ő  ő  Œ  œ  Ŕ  ŕ  Ŗ  ŗ  Ř  ř  Ś  ś  Ŝ  ŝ  Ş  ş
+/// @brief Translittération en ASCII des caractères U+0080 à U+017F (suppléments
+/// Latin-1 et Latin étendu A). Les ligatures donnent deux lettres et les
+/// caractères sans équivalent donnent '?'.
+static const char UniStr_asciiTable[0x180 - 0x80][3] = {
+    //         0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F
+    // ------------------------------------------------------
+    // U+0080  (caractères de contrôle)
+    "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?",
+    // U+0090  (caractères de contrôle)
+    "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?",
+    // U+00A0     ¡  ¢  £  ¤  ¥  ¦  §  ¨  ©  ª  «  ¬     ®  ¯
+    " ", "?", "?", "?", "?", "?", "?", "?", "?", "?", "?", "\"", "?", "-", "?", "?",
+    // U+00B0  °  ±  ²  ³  ´  µ  ¶  ·  ¸  ¹  º  »  ¼  ½  ¾  ¿
+    "?", "?", "?", "?", "'", "?", "?", ".", "?", "?", "?", "\"", "?", "?", "?", "?",
+    // U+00C0  À  Á  Â  Ã  Ä  Å  Æ  Ç  È  É  Ê  Ë  Ì  Í  Î  Ï
+    "A", "A", "A", "A", "A", "A", "AE", "C", "E", "E", "E", "E", "I", "I", "I", "I",
+    // U+00D0  Ð  Ñ  Ò  Ó  Ô  Õ  Ö  ×  Ø  Ù  Ú  Û  Ü  Ý  Þ  ß
+    "D", "N", "O", "O", "O", "O", "O", "x", "O", "U", "U", "U", "U", "Y", "TH", "ss",
+    // U+00E0  à  á  â  ã  ä  å  æ  ç  è  é  ê  ë  ì  í  î  ï
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+    // U+00F0  ð  ñ  ò  ó  ô  õ  ö  ÷  ø  ù  ú  û  ü  ý  þ  ÿ
+    "d", "n", "o", "o", "o", "o", "o", "?", "o", "u", "u", "u", "u", "y", "th", "y",
+    // U+0100  Ā  ā  Ă  ă  Ą  ą  Ć  ć  Ĉ  ĉ  Ċ  ċ  Č  č  Ď  ď
+    "A", "a", "A", "a", "A", "a", "C", "c", "C", "c", "C", "c", "C", "c", "D", "d",
+    // U+0110  Đ  đ  Ē  ē  Ĕ  ĕ  Ė  ė  Ę  ę  Ě  ě  Ĝ  ĝ  Ğ  ğ
+    "D", "d", "E", "e", "E", "e", "E", "e", "E", "e", "E", "e", "G", "g", "G", "g",
+    // U+0120  Ġ  ġ  Ģ  ģ  Ĥ  ĥ  Ħ  ħ  Ĩ  ĩ  Ī  ī  Ĭ  ĭ  Į  į
+    "G", "g", "G", "g", "H", "h", "H", "h", "I", "i", "I", "i", "I", "i", "I", "i",
+    // U+0130  İ  ı  Ĳ  ĳ  Ĵ  ĵ  Ķ  ķ  ĸ  Ĺ  ĺ  Ļ  ļ  Ľ  ľ  Ŀ
+    "I", "i", "IJ", "ij", "J", "j", "K", "k", "k", "L", "l", "L", "l", "L", "l", "L",
+    // U+0140  ŀ  Ł  ł  Ń  ń  Ņ  ņ  Ň  ň  ŉ  Ŋ  ŋ  Ō  ō  Ŏ  ŏ
+    "l", "L", "l", "N", "n", "N", "n", "N", "n", "'n", "N", "n", "O", "o", "O", "o",
+    // U+0150  Ő  ő  Œ  œ  Ŕ  ŕ  Ŗ  ŗ  Ř  ř  Ś  ś  Ŝ  ŝ  Ş  ş
+    "O", "o", "OE", "oe", "R", "r", "R", "r", "R", "r", "S", "s", "S", "s", "S", "s",
+    // U+0160  Š  š  Ţ  ţ  Ť  ť  Ŧ  ŧ  Ũ  ũ  Ū  ū  Ŭ  ŭ  Ů  ů
+    "S", "s", "T", "t", "T", "t", "T", "t", "U", "u", "U", "u", "U", "u", "U", "u",
+    // U+0170  Ű  ű  Ų  ų  Ŵ  ŵ  Ŷ  ŷ  Ÿ  Ź  ź  Ż  ż  Ž  ž  ſ
+    "U", "u", "U", "u", "W", "w", "Y", "y", "Y", "Z", "z", "Z", "z", "Z", "z", "s",
+};
+
+/// @brief Nombre maximal d'octets ASCII produits par un caractère.
+#define UNISTR_ASCII_MAX_EXPANSION 2
+
+/// @brief Renvoie la translittération en ASCII d'un caractère non ASCII
+/// (un ou deux octets, sans '\0' pour les ligatures).
+INLINE const char *UniStr_getAscii(char32 c)
+{
+    if (c < 0x180)
+        return UniStr_asciiTable[c - 0x80];
 
-char *UniStr_encodeAscii(UniStr *string)
+    switch (c)
+    {
+    case 0x2010: case 0x2011: case 0x2012: case 0x2013: case 0x2014:
+        return "-";
+    case 0x2018: case 0x2019: case 0x201A: case 0x201B:
+    case 0x2032: case 0x2035:
+        return "'";
+    case 0x201C: case 0x201D: case 0x201E: case 0x201F:
+    case 0x2033: case 0x2036:
+        return "\"";
+    default:
+        return "?";
+    }
+}
+
+/// @brief Ajoute la translittération d'un caractère non ASCII à un buffer.
+/// @return La nouvelle taille du texte (qui peut dépasser celle du buffer).
+INLINE int UniStr_appendAscii(char32 c, char *buffer, int bufferSize, int idx)
+{
+    const char *ascii = UniStr_getAscii(c);
+    for (int i = 0; i < UNISTR_ASCII_MAX_EXPANSION && ascii[i]; i++, idx++)
+    {
+        if (idx < bufferSize - 1)
+            buffer[idx] = ascii[i];
+    }
+    return idx;
+}
+
+int UniStr_encodeAsciiTo(UniStr *string, char *buffer, int bufferSize)
 {
     char32 *data = string->data;
     int sizeU32 = string->length;
-    int sizeAscii = sizeU32;
+    int idx = 0;
     for (int i = 0; i < sizeU32; i++)
     {
-        int c = (int)(data[i]);
-        switch (c)
+        char32 c = data[i];
+        if (c < 128)
         {
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00E0  à  á  â  ã  ä  å  æ  ç  è  é  ê  ë  ì  í  î  ï
-            // U+0150  Ő  ő  Œ  œ  Ŕ  ŕ  Ŗ  ŗ  Ř  ř  Ś  ś  Ŝ  ŝ  Ş  ş
-        case 0xC6: case 0xE6: case 0x152: case 0x153:
-            // AE ae OE oe
-            sizeAscii++;
-            break;
-        default:
-            break;
+            if (idx < bufferSize - 1)
+                buffer[idx] = (char)c;
+            idx++;
+        }
+        else
+        {
+            idx = UniStr_appendAscii(c, buffer, bufferSize, idx);
         }
     }
-    char *bufferAscii = (char *)calloc(sizeAscii + 1, sizeof(char));
+    if (bufferSize > 0)
+        buffer[idx < bufferSize - 1 ? idx : bufferSize - 1] = '\0';
+    return idx;
+}
+
+char *UniStr_encodeAscii(UniStr *string)
+{
+    // Un seul parcours : le buffer est dimensionné pour le pire cas.
+    int bufferSize = UNISTR_ASCII_MAX_EXPANSION * string->length + 1;
+    char *bufferAscii = (char *)calloc(bufferSize, sizeof(char));
     AssertNew(bufferAscii);
 
+    UniStr_encodeAsciiTo(string, bufferAscii, bufferSize);
+    return bufferAscii;
+}
+
+/// @brief Normalise un caractère ASCII pour les comparaisons.
+INLINE char UniStr_matchAscii(char c)
+{
+    if (c >= 'a' && c <= 'z')
+        return (char)(c - ('a' - 'A'));
+    return c == '-' ? ' ' : c;
+}
+
+int UniStr_normalizeU8(const char *bufferU8, char *buffer, int bufferSize)
+{
+    const char *curr = bufferU8;
     int idx = 0;
-    for (int i = 0; i < sizeU32; i++)
+    while (*curr)
     {
-        int c = (int)(data[i]);
-        if (c < 128)
+        if ((unsigned char)*curr < 0x80)
         {
-            bufferAscii[idx++] = (char)c;
+            // Les noms étant courts et majoritairement ASCII, ce cas est
+            // traité octet par octet sans décodage.
+            if (idx < bufferSize - 1)
+                buffer[idx] = UniStr_matchAscii(*curr);
+            idx++;
+            curr++;
             continue;
         }
-        switch (c)
+
+        // Caractère non ASCII : translittération puis normalisation.
+        char32 c;
+        const char *next = decodeUTF8((char *)curr, &c);
+        int start = idx;
+        idx = UniStr_appendAscii(c, buffer, bufferSize, idx);
+        for (int i = start; i < idx && i < bufferSize - 1; i++)
         {
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00C0  À  Á  Â  Ã  Ä  Å  Æ  Ç  È  É  Ê  Ë  Ì  Í  Î  Ï
-        case 0xC0: case 0xC1: case 0xC2: case 0xC3: case 0xC4: case 0xC5:
-            bufferAscii[idx++] = 'A';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00C0  À  Á  Â  Ã  Ä  Å  Æ  Ç  È  É  Ê  Ë  Ì  Í  Î  Ï
-        case 0xC6:
-            bufferAscii[idx++] = 'A';
-            bufferAscii[idx++] = 'E';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00C0  À  Á  Â  Ã  Ä  Å  Æ  Ç  È  É  Ê  Ë  Ì  Í  Î  Ï
-        case 0xC7:
-            bufferAscii[idx++] = 'C';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00C0  À  Á  Â  Ã  Ä  Å  Æ  Ç  È  É  Ê  Ë  Ì  Í  Î  Ï
-        case 0xC8: case 0xC9: case 0xCA: case 0xCB:
-            bufferAscii[idx++] = 'E';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00C0  À  Á  Â  Ã  Ä  Å  Æ  Ç  È  É  Ê  Ë  Ì  Í  Î  Ï
-        case 0xCC: case 0xCD: case 0xCE: case 0xCF:
-            bufferAscii[idx++] = 'I';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00D0  Ð  Ñ  Ò  Ó  Ô  Õ  Ö  ×  Ø  Ù  Ú  Û  Ü  Ý  Þ  ß
-        case 0xD0:
-            bufferAscii[idx++] = 'D';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00D0  Ð  Ñ  Ò  Ó  Ô  Õ  Ö  ×  Ø  Ù  Ú  Û  Ü  Ý  Þ  ß
-        case 0xD1:
-            bufferAscii[idx++] = 'N';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00D0  Ð  Ñ  Ò  Ó  Ô  Õ  Ö  ×  Ø  Ù  Ú  Û  Ü  Ý  Þ  ß
-        case 0xD2: case 0xD3: case 0xD4: case 0xD5: case 0xD6:
-            bufferAscii[idx++] = 'O';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00D0  Ð  Ñ  Ò  Ó  Ô  Õ  Ö  ×  Ø  Ù  Ú  Û  Ü  Ý  Þ  ß
-        case 0xD9: case 0xDA: case 0xDB: case 0xDC:
-            bufferAscii[idx++] = 'U';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00D0  Ð  Ñ  Ò  Ó  Ô  Õ  Ö  ×  Ø  Ù  Ú  Û  Ü  Ý  Þ  ß
-        case 0xDE:
-            bufferAscii[idx++] = 'Y';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00E0  à  á  â  ã  ä  å  æ  ç  è  é  ê  ë  ì  í  î  ï
-        case 0xE0: case 0xE1: case 0xE2: case 0xE3: case 0xE4: case 0xE5:
-            bufferAscii[idx++] = 'a';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00E0  à  á  â  ã  ä  å  æ  ç  è  é  ê  ë  ì  í  î  ï
-        case 0xE6:
-            bufferAscii[idx++] = 'a';
-            bufferAscii[idx++] = 'e';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00E0  à  á  â  ã  ä  å  æ  ç  è  é  ê  ë  ì  í  î  ï
-        case 0xE7:
-            bufferAscii[idx++] = 'c';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00E0  à  á  â  ã  ä  å  æ  ç  è  é  ê  ë  ì  í  î  ï
-        case 0xE8: case 0xE9: case 0xEA: case 0xEB:
-            bufferAscii[idx++] = 'e';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00E0  à  á  â  ã  ä  å  æ  ç  è  é  ê  ë  ì  í  î  ï
-        case 0xEC: case 0xED: case 0xEE: case 0xEF:
-            bufferAscii[idx++] = 'i';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00F0  ð  ñ  ò  ó  ô  õ  ö  ÷  ø  ù  ú  û  ü  ý  þ  ÿ
-        case 0xF0:
-            bufferAscii[idx++] = 'd';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00F0  ð  ñ  ò  ó  ô  õ  ö  ÷  ø  ù  ú  û  ü  ý  þ  ÿ
-        case 0xF1:
-            bufferAscii[idx++] = 'n';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00F0  ð  ñ  ò  ó  ô  õ  ö  ÷  ø  ù  ú  û  ü  ý  þ  ÿ
-        case 0xF2: case 0xF3: case 0xF4: case 0xF5: case 0xF6:
-            bufferAscii[idx++] = 'o';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00F0  ð  ñ  ò  ó  ô  õ  ö  ÷  ø  ù  ú  û  ü  ý  þ  ÿ
-        case 0xF9: case 0xFA: case 0xFB: case 0xFC:
-            bufferAscii[idx++] = 'u';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+00F0  ð  ñ  ò  ó  ô  õ  ö  ÷  ø  ù  ú  û  ü  ý  þ  ÿ
-        case 0xFE: case 0xFF:
-            bufferAscii[idx++] = 'y';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+0150  Ő  ő  Œ  œ  Ŕ  ŕ  Ŗ  ŗ  Ř  ř  Ś  ś  Ŝ  ŝ  Ş  ş
-        case 0x152:
-            bufferAscii[idx++] = 'O';
-            bufferAscii[idx++] = 'E';
-            break;
-            //         0  1  2  3  4  5  6  7  8  9  A  B  C  E  D  F
-            // U+0150  Ő  ő  Œ  œ  Ŕ  ŕ  Ŗ  ŗ  Ř  ř  Ś  ś  Ŝ  ŝ  Ş  ş
-        case 0x153:
-            bufferAscii[idx++] = 'o';
-            bufferAscii[idx++] = 'e';
-            break;
-        case 0xB4: case 0x2018: case 0x2019: case 0x201A: case 0x201B:
-        case 0x2032: case 0x2035:
-            bufferAscii[idx++] = '\'';
-            break;
-        case 0x201C: case 0x201D: case 0x201E: case 0x201F:
-        case 0x2033: case 0x2036:
-            bufferAscii[idx++] = '\"';
-            break;
-        default:
-            bufferAscii[idx++] = '?';
-            break;
+            buffer[i] = UniStr_matchAscii(buffer[i]);
         }
+        // Une séquence tronquée par le '\0' final s'arrête sur celui-ci.
+        while (curr + 1 < next && curr[1])
+            curr++;
+        curr++;
     }
-
-    return bufferAscii;
+    if (bufferSize > 0)
+        buffer[idx < bufferSize - 1 ? idx : bufferSize - 1] = '\0';
+    return idx;
 }
 
 void UniStr_print(UniStr *string)
@@ -453,7 +642,7 @@ bool UniStr_isSubAt(UniStr *string, UniStr *sub, int index)
     int strLen = string->length;
     int subLen = sub->length;
 
-    if (index < 0 || index + subLen >= strLen)
+    if (index < 0 || index + subLen > strLen)
         return false;
 
     for (int i = 0; i < subLen; i++)
@@ -495,43 +684,302 @@ UniStr *UniStr_slice(UniStr *string, int start, int end)
     return sub;
 }
 
+/// @brief Renvoie la position de la première occurrence d'un caractère à
+/// partir d'une position, ou la longueur de la chaîne s'il est absent.
+/// Les caractères sont comparés 4 par 4 avec SSE2.
+INLINE int UniStr_findChar(const char32 *data, int start, int length, char32 c)
+{
+    int i = start;
+#ifdef UNISTR_SIMD
+    const __m128i target = _mm_set1_epi32((int)c);
+    for (; i + 4 <= length; i += 4)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, target)));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    while (i < length && data[i] != c)
+        i++;
+    return i;
+}
+
+// Les recherches de sous-chaînes utilisent l'algorithme Two-Way de Crochemore
+// et Perrin : la sous-chaîne est coupée en deux selon une factorisation
+// critique, la partie droite est comparée de gauche à droite puis la partie
+// gauche de droite à gauche. Les décalages garantissent un temps linéaire en
+// la taille de la chaîne et de la sous-chaîne, sans mémoire supplémentaire.
+
+/// @brief Structure contenant la factorisation critique d'une sous-chaîne.
+typedef struct sUniStrTwoWay
+{
+    /// @brief La sous-chaîne.
+    const char32 *sub;
+
+    /// @brief Longueur de la sous-chaîne.
+    int subLen;
+
+    /// @brief Position du dernier caractère de la partie gauche.
+    int ell;
+
+    /// @brief Décalage appliqué après une occurrence.
+    int period;
+
+    /// @brief true si la sous-chaîne est périodique : le début déjà reconnu
+    /// après un décalage n'est alors pas comparé de nouveau.
+    bool periodic;
+
+    /// @brief true si les chaînes sont lues de la fin vers le début.
+    bool reverse;
+} UniStrTwoWay;
+
+/// @brief Renvoie le caractère d'indice i d'un tableau, compté depuis la fin
+/// si reverse vaut true.
+INLINE char32 UniStr_at(const char32 *data, int length, int i, bool reverse)
+{
+    return data[reverse ? length - 1 - i : i];
+}
+
+/// @brief Calcule la position du suffixe maximal d'une chaîne pour l'ordre
+/// des caractères (ou l'ordre contraire si inverted vaut true) et sa période.
+static int UniStr_maxSuffix(const char32 *sub, int subLen, bool reverse, bool inverted, int *period)
+{
+    int suffix = -1;
+    int j = 0;
+    int k = 1;
+    *period = 1;
+    while (j + k < subLen)
+    {
+        char32 a = UniStr_at(sub, subLen, j + k, reverse);
+        char32 b = UniStr_at(sub, subLen, suffix + k, reverse);
+        if (a == b)
+        {
+            if (k != *period)
+            {
+                k++;
+            }
+            else
+            {
+                j += *period;
+                k = 1;
+            }
+        }
+        else if ((a < b) != inverted)
+        {
+            j += k;
+            k = 1;
+            *period = j - suffix;
+        }
+        else
+        {
+            suffix = j++;
+            k = *period = 1;
+        }
+    }
+    return suffix;
+}
+
+/// @brief Calcule la factorisation critique d'une sous-chaîne (au moins deux
+/// caractères).
+static void UniStrTwoWay_init(UniStrTwoWay *tw, const char32 *sub, int subLen, bool reverse)
+{
+    int period1, period2;
+    int suffix1 = UniStr_maxSuffix(sub, subLen, reverse, false, &period1);
+    int suffix2 = UniStr_maxSuffix(sub, subLen, reverse, true, &period2);
+
+    tw->sub = sub;
+    tw->subLen = subLen;
+    tw->reverse = reverse;
+    tw->ell = suffix1 > suffix2 ? suffix1 : suffix2;
+    tw->period = suffix1 > suffix2 ? period1 : period2;
+
+    // La sous-chaîne est périodique si la partie gauche se retrouve une
+    // période plus loin.
+    tw->periodic = tw->ell + tw->period < subLen;
+    for (int i = 0; tw->periodic && i <= tw->ell; i++)
+    {
+        tw->periodic = UniStr_at(sub, subLen, i, reverse) ==
+            UniStr_at(sub, subLen, i + tw->period, reverse);
+    }
+    if (!tw->periodic)
+    {
+        int left = tw->ell + 1;
+        int right = subLen - tw->ell - 1;
+        tw->period = (left > right ? left : right) + 1;
+    }
+}
+
+/// @brief Renvoie la première position j de [start, last] telle que les
+/// caractères data[j] et data[j + subLen - 1] soient le premier et le dernier
+/// de la sous-chaîne, ou last + 1 s'il n'y en a pas.
+/// Les positions sont testées 4 par 4 avec SSE2.
+INLINE int UniStr_findCandidate(const char32 *data, int start, int last, const char32 *sub, int subLen)
+{
+    int j = start;
+#ifdef UNISTR_SIMD
+    const __m128i first = _mm_set1_epi32((int)sub[0]);
+    const __m128i final = _mm_set1_epi32((int)sub[subLen - 1]);
+    for (; j + 4 <= last + 1; j += 4)
+    {
+        __m128i blockFirst = _mm_loadu_si128((const __m128i *)(data + j));
+        __m128i blockFinal = _mm_loadu_si128((const __m128i *)(data + j + subLen - 1));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(
+            _mm_cmpeq_epi32(blockFirst, first), _mm_cmpeq_epi32(blockFinal, final))));
+        if (mask)
+            return j + __builtin_ctz(mask);
+    }
+#endif
+    while (j <= last && (data[j] != sub[0] || data[j + subLen - 1] != sub[subLen - 1]))
+        j++;
+    return j;
+}
+
+/// @brief Cherche une sous-chaîne à partir d'une position.
+/// Les positions sont comptées depuis la fin si la factorisation a été
+/// calculée avec reverse.
+/// @param tw la factorisation critique de la sous-chaîne.
+/// @param data la chaîne.
+/// @param length la longueur de la chaîne.
+/// @param start la position à partir de laquelle chercher.
+/// @param[out] count si différent de NULL, reçoit le nombre total
+/// d'occurrences (qui peuvent se chevaucher) après start.
+/// @return La position de la première occurrence ou -1 si elle est absente.
+static int UniStrTwoWay_find(const UniStrTwoWay *tw, const char32 *data, int length, int start, int *count)
+{
+    const char32 *sub = tw->sub;
+    int subLen = tw->subLen;
+    int ell = tw->ell;
+    bool reverse = tw->reverse;
+    int first = -1;
+    int memory = -1;
+    if (count) *count = 0;
+
+    for (int j = start; j <= length - subLen; )
+    {
+        if (!reverse && memory < 0)
+        {
+            // Saut direct à la prochaine position où le premier et le
+            // dernier caractère correspondent.
+            j = UniStr_findCandidate(data, j, length - subLen, sub, subLen);
+            if (j > length - subLen)
+                break;
+        }
+
+        // Partie droite, de gauche à droite.
+        int i = (memory > ell ? memory : ell) + 1;
+        while (i < subLen && UniStr_at(sub, subLen, i, reverse) == UniStr_at(data, length, i + j, reverse))
+            i++;
+        if (i < subLen)
+        {
+            j += i - ell;
+            memory = -1;
+            continue;
+        }
+
+        // Partie gauche, de droite à gauche.
+        i = ell;
+        while (i > memory && UniStr_at(sub, subLen, i, reverse) == UniStr_at(data, length, i + j, reverse))
+            i--;
+        if (i <= memory)
+        {
+            if (!count)
+                return j;
+            if (first < 0)
+                first = j;
+            (*count)++;
+        }
+        j += tw->period;
+        memory = tw->periodic ? subLen - tw->period - 1 : -1;
+    }
+    return first;
+}
+
 int UniStr_count(UniStr *string, UniStr *sub)
 {
-    int count = 0;
     int strLen = string->length;
-    for (int i = 0; i < strLen; i++)
+    int subLen = sub->length;
+    if (subLen <= 0 || subLen > strLen)
+        return 0;
+
+    int count = 0;
+    if (subLen == 1)
     {
-        if (UniStr_isSubAt(string, sub, i))
+        for (int i = UniStr_findChar(string->data, 0, strLen, sub->data[0]); i < strLen;
+             i = UniStr_findChar(string->data, i + 1, strLen, sub->data[0]))
         {
             count++;
         }
+        return count;
     }
+
+    UniStrTwoWay tw;
+    UniStrTwoWay_init(&tw, sub->data, subLen, false);
+    UniStrTwoWay_find(&tw, string->data, strLen, 0, &count);
     return count;
 }
 
 int UniStr_find(UniStr *string, UniStr *sub)
 {
     int strLen = string->length;
-    for (int i = 0; i < strLen; i++)
+    int subLen = sub->length;
+    if (subLen <= 0 || subLen > strLen)
+        return -1;
+
+    if (subLen == 1)
+    {
+        int index = UniStr_findChar(string->data, 0, strLen, sub->data[0]);
+        return index < strLen ? index : -1;
+    }
+
+    UniStrTwoWay tw;
+    UniStrTwoWay_init(&tw, sub->data, subLen, false);
+    return UniStrTwoWay_find(&tw, string->data, strLen, 0, NULL);
+}
+
+int UniStr_rfind(UniStr *string, UniStr *sub)
+{
+    int strLen = string->length;
+    int subLen = sub->length;
+    if (subLen <= 0 || subLen > strLen)
+        return -1;
+
+    if (subLen == 1)
     {
-        if (UniStr_isSubAt(string, sub, i))
+        for (int i = strLen - 1; i >= 0; i--)
         {
-            return i;
+            if (string->data[i] == sub->data[0])
+                return i;
         }
+        return -1;
     }
-    return -1;
+
+    // Recherche de la première occurrence dans les chaînes lues à l'envers.
+    UniStrTwoWay tw;
+    UniStrTwoWay_init(&tw, sub->data, subLen, true);
+    int index = UniStrTwoWay_find(&tw, string->data, strLen, 0, NULL);
+    return index >= 0 ? strLen - index - subLen : -1;
 }
 
-int UniStr_rfind(UniStr *string, UniStr *sub)
+int UniStr_splitBounds(UniStr *string, char32 sep, int *starts, int *lengths, int maxCount)
 {
-    for (int i = string->length - sub->length; i >= 0; i--)
+    int count = 0;
+    int start = 0;
+    while (true)
     {
-        if (UniStr_isSubAt(string, sub, i))
+        int end = UniStr_findChar(string->data, start, string->length, sep);
+        if (count < maxCount)
         {
-            return i;
+            starts[count] = start;
+            lengths[count] = end - start;
         }
+        count++;
+
+        if (end >= string->length)
+            break;
+        start = end + 1;
     }
-    return -1;
+    return count;
 }
 
 UniStr **UniStr_split(UniStr *string, UniStr *sep, int *subCount)
@@ -541,15 +989,44 @@ UniStr **UniStr_split(UniStr *string, UniStr *sep, int *subCount)
     int strLen = string->length;
     int sepLen = sep->length;
 
-    int count = 1;
-    for (int i = 0; i < strLen; )
+    if (sepLen <= 0)
+    {
+        // Séparateur vide : la chaîne n'est pas découpée.
+        UniStr **subStrings = (UniStr **)calloc(1, sizeof(UniStr *));
+        AssertNew(subStrings);
+        subStrings[0] = UniStr_copy(string);
+        *subCount = 1;
+        return subStrings;
+    }
+
+    if (sepLen == 1)
     {
-        if (UniStr_isSubAt(string, sep, i))
+        // Séparateur d'un seul caractère : recherche directe du caractère.
+        int count = UniStr_splitBounds(string, sepData[0], NULL, NULL, 0);
+        UniStr **subStrings = (UniStr **)calloc(count, sizeof(UniStr *));
+        AssertNew(subStrings);
+
+        int start = 0;
+        for (int i = 0; i < count; i++)
         {
-            count++;
-            i += sepLen;
+            int end = UniStr_findChar(strData, start, strLen, sepData[0]);
+            subStrings[i] = UniStr_slice(string, start, end);
+            start = end + 1;
         }
-        else i++;
+
+        *subCount = count;
+        return subStrings;
+    }
+
+    // Séparateur de plusieurs caractères : occurrences disjointes trouvées
+    // avec l'algorithme Two-Way.
+    UniStrTwoWay tw;
+    UniStrTwoWay_init(&tw, sepData, sepLen, false);
+    int count = 1;
+    for (int i = UniStrTwoWay_find(&tw, strData, strLen, 0, NULL); i >= 0;
+         i = UniStrTwoWay_find(&tw, strData, strLen, i + sepLen, NULL))
+    {
+        count++;
     }
 
     UniStr **subStrings = (UniStr **)calloc(count, sizeof(UniStr *));
@@ -557,15 +1034,11 @@ UniStr **UniStr_split(UniStr *string, UniStr *sep, int *subCount)
 
     int subIdx = 0;
     int start = 0;
-    for (int i = 0; i < strLen; )
+    for (int i = UniStrTwoWay_find(&tw, strData, strLen, 0, NULL); i >= 0;
+         i = UniStrTwoWay_find(&tw, strData, strLen, start, NULL))
     {
-        if (UniStr_isSubAt(string, sep, i))
-        {
-            subStrings[subIdx++] = UniStr_slice(string, start, i);
-            i += sepLen;
-            start = i;
-        }
-        else i++;
+        subStrings[subIdx++] = UniStr_slice(string, start, i);
+        start = i + sepLen;
     }
     subStrings[subIdx++] = UniStr_slice(string, start, strLen);
 
@@ -607,11 +1080,14 @@ UniStr *UniStr_copy(UniStr *string)
     return res;
 }
 
-char *UniStr_getNumberStr(UniStr *string, int *start)
+/// @brief Copie en ASCII les caractères d'un nombre dans un buffer.
+/// @param string la chaîne.
+/// @param start position de début, mise à jour après les espaces initiaux.
+/// @param res buffer de UNISTR_NUMBER_MAX_LEN + 1 caractères.
+/// @return Le nombre de caractères copiés.
+static int UniStr_getNumberStr(UniStr *string, int *start, char *res)
 {
-    int maxLen = 64;
-    char *res = (char *)calloc(maxLen + 1, sizeof(char));
-    AssertNew(res);
+    int maxLen = UNISTR_NUMBER_MAX_LEN;
 
     int i = *start;
     for (; i < string->length; i++)
@@ -650,48 +1126,48 @@ char *UniStr_getNumberStr(UniStr *string, int *start)
         }
         else break;
     }
-    res[resIdx++] = '\0';
+    res[resIdx] = '\0';
 
-    return res;
+    return resIdx;
 }
 
 int UniStr_getInt(UniStr *string, int start, int *end)
 {
-    char *buffer = UniStr_getNumberStr(string, &start);
+    char buffer[UNISTR_NUMBER_MAX_LEN + 1];
+    UniStr_getNumberStr(string, &start, buffer);
     char *endPtr = NULL;
     long value = strtol(buffer, &endPtr, 10);
     if (end) *end = start + (int)(endPtr - buffer);
-    free(buffer);
     return (int)value;
 }
 
 double UniStr_getFloat(UniStr *string, int start, int *end)
 {
-    char *buffer = UniStr_getNumberStr(string, &start);
+    char buffer[UNISTR_NUMBER_MAX_LEN + 1];
+    UniStr_getNumberStr(string, &start, buffer);
     char *endPtr = NULL;
     float value = strtof(buffer, &endPtr);
     if (end) *end = start + (int)(endPtr - buffer);
-    free(buffer);
     return value;
 }
 
 double UniStr_getDouble(UniStr *string, int start, int *end)
 {
-    char *buffer = UniStr_getNumberStr(string, &start);
-    char *endPtr = NULL;
-    double value = strtod(buffer, &endPtr);
-    if (end) *end = start + (int)(endPtr - buffer);
-    free(buffer);
+    char buffer[UNISTR_NUMBER_MAX_LEN + 1];
+    int length = UniStr_getNumberStr(string, &start, buffer);
+    int numberLength = 0;
+    double value = Number_parseDouble(buffer, length, &numberLength);
+    if (end) *end = start + numberLength;
     return value;
 }
 
 unsigned long long UniStr_getULL(UniStr *string, int start, int *end)
 {
-    char *buffer = UniStr_getNumberStr(string, &start);
+    char buffer[UNISTR_NUMBER_MAX_LEN + 1];
+    UniStr_getNumberStr(string, &start, buffer);
     char *endPtr = NULL;
     unsigned long long value = strtoull(buffer, &endPtr, 10);
     if (end) *end = start + (int)(endPtr - buffer);
-    free(buffer);
     return value;
 }
 
@@ -2,6 +2,9 @@
 
 #include "settings.h"
 
+/// @brief Dsactive les traitements vectoriels (SSE2/AVX2) du dcodage UTF8.
+//#define _UNISTR_SCALAR
+
 typedef unsigned int char32;
 
 typedef struct UniStr_s
@@ -19,6 +22,28 @@ UniStr *UniStr_decodeAscii(char *bufferU8, int bufferSize);
 char *UniStr_encodeU8(UniStr *string);
 char *UniStr_encodeAscii(UniStr *string);
 
+/// @brief Translittre une chane en ASCII dans un buffer fourni, sans
+/// allocation (voir UniStr_encodeAscii()).
+/// Un caractre donne au plus deux octets (ligatures , ...).
+/// @param string la chane.
+/// @param buffer le buffer de destination.
+/// @param bufferSize la taille du buffer ('\0' compris). Le texte est tronqu
+/// si le buffer est trop petit.
+/// @return La taille du texte translittr sans le '\0', qui peut dpasser
+/// bufferSize - 1 (comme snprintf()).
+int UniStr_encodeAsciiTo(UniStr *string, char *buffer, int bufferSize);
+
+/// @brief Normalise une chane code en UTF8 pour les comparaisons en un seul
+/// parcours et sans crer de UniStr : translittration en ASCII, passage en
+/// majuscules et remplacement des tirets par des espaces.
+/// Le texte normalis n'est jamais plus long que la chane d'origine.
+/// @param bufferU8 la chane termine par '\0'.
+/// @param buffer le buffer de destination.
+/// @param bufferSize la taille du buffer ('\0' compris). Le texte est tronqu
+/// si le buffer est trop petit.
+/// @return La taille du texte normalis sans le '\0'.
+int UniStr_normalizeU8(const char *bufferU8, char *buffer, int bufferSize);
+
 void UniStr_print(UniStr *string);
 
 UniStr *UniStr_slice(UniStr *string, int start, int end);
@@ -29,6 +54,19 @@ int UniStr_find(UniStr *string, UniStr *sub);
 int UniStr_rfind(UniStr *string, UniStr *sub);
 UniStr **UniStr_split(UniStr *string, UniStr *sep, int *subCount);
 
+/// @brief Dcoupe une chane selon un caractre sparateur sans copier les
+/// sous-chanes : seules leurs positions sont crites.
+/// Une chane contenant n sparateurs donne n + 1 sous-chanes, ventuellement
+/// vides.
+/// @param string la chane.
+/// @param sep le caractre sparateur.
+/// @param[out] starts tableau de maxCount positions de dbut.
+/// @param[out] lengths tableau de maxCount longueurs.
+/// @param maxCount la taille des tableaux (les sous-chanes suivantes sont
+/// seulement comptes).
+/// @return Le nombre de sous-chanes, qui peut dpasser maxCount.
+int UniStr_splitBounds(UniStr *string, char32 sep, int *starts, int *lengths, int maxCount);
+
 UniStr *UniStr_join(UniStr *string1, UniStr *string2);
 UniStr *UniStr_copy(UniStr *string);
 
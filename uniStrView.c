@@ -0,0 +1,409 @@
+#include "uniStrView.h"
+#include "uniStr.h"
+#include "number.h"
+
+// Les positions candidates des recherches de sous-chaînes sont filtrées 16 par
+// 16 avec les instructions SSE2 (voir _UNISTR_SCALAR dans uniStr.h).
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(_UNISTR_SCALAR)
+#define UNISTR_VIEW_SIMD
+#include <immintrin.h>
+#endif
+
+/// @brief Renvoie la minuscule d'une lettre ASCII, l'octet inchangé sinon.
+INLINE unsigned char UniStrView_foldAscii(unsigned char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+/// @brief Indique si un octet est un espace ASCII.
+INLINE bool UniStrView_isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+UniStrView UniStrView_make(const char *data, int length)
+{
+    UniStrView view;
+    view.data = data;
+    view.length = length >= 0 ? length : (int)strlen(data);
+    return view;
+}
+
+int UniStrView_getLength(UniStrView view)
+{
+    // Chaque caractère compte exactement un octet qui n'est pas de la forme
+    // 10xxxxxx.
+    int count = 0;
+    for (int i = 0; i < view.length; i++)
+    {
+        count += ((unsigned char)view.data[i] & 0xC0) != 0x80;
+    }
+    return count;
+}
+
+UniStrView UniStrView_slice(UniStrView view, int start, int end)
+{
+    if (start < 0) start = 0;
+    if (end > view.length) end = view.length;
+    if (end < start) end = start;
+    if (start > view.length) start = end = view.length;
+    return UniStrView_make(view.data + start, end - start);
+}
+
+UniStrView UniStrView_trim(UniStrView view)
+{
+    int start = 0;
+    int end = view.length;
+    while (start < end && UniStrView_isSpace(view.data[start]))
+        start++;
+    while (end > start && UniStrView_isSpace(view.data[end - 1]))
+        end--;
+    return UniStrView_make(view.data + start, end - start);
+}
+
+bool UniStrView_equals(UniStrView view1, UniStrView view2)
+{
+    return view1.length == view2.length &&
+        memcmp(view1.data, view2.data, view1.length) == 0;
+}
+
+int UniStrView_compareAsciiFold(UniStrView view1, UniStrView view2)
+{
+    int length = view1.length < view2.length ? view1.length : view2.length;
+    for (int i = 0; i < length; i++)
+    {
+        unsigned char c1 = UniStrView_foldAscii((unsigned char)view1.data[i]);
+        unsigned char c2 = UniStrView_foldAscii((unsigned char)view2.data[i]);
+        if (c1 != c2)
+            return (int)c1 - (int)c2;
+    }
+    return (view1.length > view2.length) - (view1.length < view2.length);
+}
+
+bool UniStrView_equalsAsciiFold(UniStrView view1, UniStrView view2)
+{
+    return view1.length == view2.length &&
+        UniStrView_compareAsciiFold(view1, view2) == 0;
+}
+
+bool UniStrView_startsWith(UniStrView view, UniStrView prefix)
+{
+    return view.length >= prefix.length &&
+        memcmp(view.data, prefix.data, prefix.length) == 0;
+}
+
+// Comme pour UniStr, les recherches de sous-chaînes utilisent l'algorithme
+// Two-Way de Crochemore et Perrin, ici sur les octets.
+
+/// @brief Structure contenant la factorisation critique d'une sous-chaîne.
+typedef struct sUniStrViewTwoWay
+{
+    /// @brief La sous-chaîne.
+    const unsigned char *sub;
+
+    /// @brief Taille de la sous-chaîne.
+    int subLen;
+
+    /// @brief Position du dernier octet de la partie gauche.
+    int ell;
+
+    /// @brief Décalage appliqué après une occurrence.
+    int period;
+
+    /// @brief true si la sous-chaîne est périodique.
+    bool periodic;
+
+    /// @brief true si les chaînes sont lues de la fin vers le début.
+    bool reverse;
+} UniStrViewTwoWay;
+
+/// @brief Renvoie l'octet d'indice i, compté depuis la fin si reverse vaut
+/// true.
+INLINE unsigned char UniStrView_at(const unsigned char *data, int length, int i, bool reverse)
+{
+    return data[reverse ? length - 1 - i : i];
+}
+
+/// @brief Calcule la position du suffixe maximal d'une chaîne pour l'ordre
+/// des octets (ou l'ordre contraire si inverted vaut true) et sa période.
+static int UniStrView_maxSuffix(const unsigned char *sub, int subLen, bool reverse, bool inverted, int *period)
+{
+    int suffix = -1;
+    int j = 0;
+    int k = 1;
+    *period = 1;
+    while (j + k < subLen)
+    {
+        unsigned char a = UniStrView_at(sub, subLen, j + k, reverse);
+        unsigned char b = UniStrView_at(sub, subLen, suffix + k, reverse);
+        if (a == b)
+        {
+            if (k != *period)
+            {
+                k++;
+            }
+            else
+            {
+                j += *period;
+                k = 1;
+            }
+        }
+        else if ((a < b) != inverted)
+        {
+            j += k;
+            k = 1;
+            *period = j - suffix;
+        }
+        else
+        {
+            suffix = j++;
+            k = *period = 1;
+        }
+    }
+    return suffix;
+}
+
+/// @brief Calcule la factorisation critique d'une sous-chaîne (au moins deux
+/// octets).
+static void UniStrViewTwoWay_init(UniStrViewTwoWay *tw, UniStrView sub, bool reverse)
+{
+    const unsigned char *data = (const unsigned char *)sub.data;
+    int period1, period2;
+    int suffix1 = UniStrView_maxSuffix(data, sub.length, reverse, false, &period1);
+    int suffix2 = UniStrView_maxSuffix(data, sub.length, reverse, true, &period2);
+
+    tw->sub = data;
+    tw->subLen = sub.length;
+    tw->reverse = reverse;
+    tw->ell = suffix1 > suffix2 ? suffix1 : suffix2;
+    tw->period = suffix1 > suffix2 ? period1 : period2;
+
+    tw->periodic = tw->ell + tw->period < sub.length;
+    for (int i = 0; tw->periodic && i <= tw->ell; i++)
+    {
+        tw->periodic = UniStrView_at(data, sub.length, i, reverse) ==
+            UniStrView_at(data, sub.length, i + tw->period, reverse);
+    }
+    if (!tw->periodic)
+    {
+        int left = tw->ell + 1;
+        int right = sub.length - tw->ell - 1;
+        tw->period = (left > right ? left : right) + 1;
+    }
+}
+
+/// @brief Renvoie la première position j de [start, last] telle que les
+/// octets data[j] et data[j + subLen - 1] soient le premier et le dernier de
+/// la sous-chaîne, ou last + 1 s'il n'y en a pas.
+/// Les positions sont testées 16 par 16 avec SSE2.
+INLINE int UniStrView_findCandidate(
+    const unsigned char *data, int start, int last, const unsigned char *sub, int subLen)
+{
+    int j = start;
+#ifdef UNISTR_VIEW_SIMD
+    const __m128i first = _mm_set1_epi8((char)sub[0]);
+    const __m128i final = _mm_set1_epi8((char)sub[subLen - 1]);
+    for (; j + 16 <= last + 1; j += 16)
+    {
+        __m128i blockFirst = _mm_loadu_si128((const __m128i *)(data + j));
+        __m128i blockFinal = _mm_loadu_si128((const __m128i *)(data + j + subLen - 1));
+        int mask = _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockFinal, final)));
+        if (mask)
+            return j + __builtin_ctz(mask);
+    }
+#endif
+    while (j <= last && (data[j] != sub[0] || data[j + subLen - 1] != sub[subLen - 1]))
+        j++;
+    return j;
+}
+
+/// @brief Cherche une sous-chaîne dans une vue (voir UniStrTwoWay_find()).
+/// @return La position de la première occurrence ou -1 si elle est absente.
+static int UniStrViewTwoWay_find(const UniStrViewTwoWay *tw, UniStrView view, int *count)
+{
+    const unsigned char *data = (const unsigned char *)view.data;
+    int length = view.length;
+    const unsigned char *sub = tw->sub;
+    int subLen = tw->subLen;
+    int ell = tw->ell;
+    bool reverse = tw->reverse;
+    int first = -1;
+    int memory = -1;
+    if (count) *count = 0;
+
+    for (int j = 0; j <= length - subLen; )
+    {
+        if (!reverse && memory < 0)
+        {
+            // Saut direct à la prochaine position où le premier et le
+            // dernier octet correspondent.
+            j = UniStrView_findCandidate(data, j, length - subLen, sub, subLen);
+            if (j > length - subLen)
+                break;
+        }
+
+        // Partie droite, de gauche à droite.
+        int i = (memory > ell ? memory : ell) + 1;
+        while (i < subLen && UniStrView_at(sub, subLen, i, reverse) == UniStrView_at(data, length, i + j, reverse))
+            i++;
+        if (i < subLen)
+        {
+            j += i - ell;
+            memory = -1;
+            continue;
+        }
+
+        // Partie gauche, de droite à gauche.
+        i = ell;
+        while (i > memory && UniStrView_at(sub, subLen, i, reverse) == UniStrView_at(data, length, i + j, reverse))
+            i--;
+        if (i <= memory)
+        {
+            if (!count)
+                return j;
+            if (first < 0)
+                first = j;
+            (*count)++;
+        }
+        j += tw->period;
+        memory = tw->periodic ? subLen - tw->period - 1 : -1;
+    }
+    return first;
+}
+
+int UniStrView_find(UniStrView view, UniStrView sub)
+{
+    if (sub.length <= 0 || sub.length > view.length)
+        return -1;
+
+    if (sub.length == 1)
+    {
+        const char *curr = memchr(view.data, sub.data[0], view.length);
+        return curr ? (int)(curr - view.data) : -1;
+    }
+
+    UniStrViewTwoWay tw;
+    UniStrViewTwoWay_init(&tw, sub, false);
+    return UniStrViewTwoWay_find(&tw, view, NULL);
+}
+
+int UniStrView_rfind(UniStrView view, UniStrView sub)
+{
+    if (sub.length <= 0 || sub.length > view.length)
+        return -1;
+
+    if (sub.length == 1)
+    {
+        for (int i = view.length - 1; i >= 0; i--)
+        {
+            if (view.data[i] == sub.data[0])
+                return i;
+        }
+        return -1;
+    }
+
+    // Recherche de la première occurrence dans les chaînes lues à l'envers.
+    UniStrViewTwoWay tw;
+    UniStrViewTwoWay_init(&tw, sub, true);
+    int index = UniStrViewTwoWay_find(&tw, view, NULL);
+    return index >= 0 ? view.length - index - sub.length : -1;
+}
+
+int UniStrView_count(UniStrView view, UniStrView sub)
+{
+    if (sub.length <= 0 || sub.length > view.length)
+        return 0;
+
+    if (sub.length == 1)
+    {
+        int count = 0;
+        const char *curr = view.data;
+        const char *end = view.data + view.length;
+        while ((curr = memchr(curr, sub.data[0], end - curr)) != NULL)
+        {
+            count++;
+            curr++;
+        }
+        return count;
+    }
+
+    UniStrViewTwoWay tw;
+    UniStrViewTwoWay_init(&tw, sub, false);
+    int count = 0;
+    UniStrViewTwoWay_find(&tw, view, &count);
+    return count;
+}
+
+bool UniStrView_splitNext(UniStrView *rest, UniStrView sep, UniStrView *part)
+{
+    if (!rest->data)
+        return false;
+
+    int index = UniStrView_find(*rest, sep);
+    if (index < 0)
+    {
+        // Dernière partie
+        *part = *rest;
+        rest->data = NULL;
+        rest->length = 0;
+        return true;
+    }
+
+    *part = UniStrView_make(rest->data, index);
+    *rest = UniStrView_slice(*rest, index + sep.length, rest->length);
+    return true;
+}
+
+long long UniStrView_getInt(UniStrView view, int start, int *end)
+{
+    int i = start < 0 ? 0 : start;
+    while (i < view.length && UniStrView_isSpace(view.data[i]))
+        i++;
+
+    bool negative = false;
+    if (i < view.length && (view.data[i] == '-' || view.data[i] == '+'))
+    {
+        negative = view.data[i] == '-';
+        i++;
+    }
+
+    int digitStart = i;
+    unsigned long long value = 0;
+    unsigned long long limit = negative ? (unsigned long long)LLONG_MAX + 1 : LLONG_MAX;
+    for (; i < view.length && view.data[i] >= '0' && view.data[i] <= '9'; i++)
+    {
+        unsigned int digit = view.data[i] - '0';
+        value = (value > (limit - digit) / 10) ? limit : 10 * value + digit;
+    }
+
+    if (i == digitStart)
+    {
+        if (end) *end = start;
+        return 0;
+    }
+    if (end) *end = i;
+    if (negative)
+        return value == limit ? LLONG_MIN : -(long long)value;
+    return (long long)value;
+}
+
+double UniStrView_getDouble(UniStrView view, int start, int *end)
+{
+    UniStrView rest = UniStrView_slice(view, start, view.length);
+    int read = 0;
+    double value = Number_parseDouble(rest.data, rest.length, &read);
+    if (end) *end = read > 0 ? (int)(rest.data - view.data) + read : start;
+    return value;
+}
+
+int UniStrView_copyTo(UniStrView view, char *buffer, int bufferSize)
+{
+    if (bufferSize <= 0)
+        return 0;
+
+    int length = view.length < bufferSize - 1 ? view.length : bufferSize - 1;
+    Memcpy(buffer, bufferSize, view.data, length);
+    buffer[length] = '\0';
+    return length;
+}
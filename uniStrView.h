@@ -0,0 +1,139 @@
+#pragma once
+
+#include "settings.h"
+
+/// @brief Structure représentant une vue sur une chaîne de caractères codée
+/// en UTF8.
+/// La vue ne possède pas son contenu : elle désigne une zone mémoire (par
+/// exemple un champ d'un fichier projeté en mémoire) qui doit rester valide
+/// tant que la vue est utilisée. Cette zone n'est pas nécessairement terminée
+/// par '\0'.
+/// Aucune fonction de ce module n'alloue de mémoire ni ne décode la chaîne :
+/// les positions et les tailles sont exprimées en octets. Les séparateurs et
+/// sous-chaînes recherchés étant eux-mêmes en UTF8 valide, une correspondance
+/// ne peut pas commencer au milieu d'un caractère.
+/// UniStr reste à utiliser lorsqu'il faut indexer les caractères.
+typedef struct UniStrView_s
+{
+    /// @brief Début de la chaîne.
+    const char *data;
+
+    /// @brief Taille de la chaîne en octets.
+    int length;
+} UniStrView;
+
+/// @brief Crée une vue sur une chaîne.
+/// @param data la chaîne.
+/// @param length la taille de la chaîne en octets, ou -1 si elle est terminée
+/// par '\0'.
+/// @return La vue.
+UniStrView UniStrView_make(const char *data, int length);
+
+/// @brief Renvoie le nombre de caractères d'une vue (et non d'octets).
+/// @param view la vue.
+/// @return Le nombre de caractères.
+int UniStrView_getLength(UniStrView view);
+
+/// @brief Renvoie une sous-vue.
+/// Les positions sont ramenées dans les limites de la vue.
+/// @param view la vue.
+/// @param start la position du premier octet.
+/// @param end la position qui suit le dernier octet.
+/// @return La sous-vue [start, end[.
+UniStrView UniStrView_slice(UniStrView view, int start, int end);
+
+/// @brief Renvoie une vue sans les espaces ASCII initiaux et finaux.
+/// @param view la vue.
+/// @return La vue réduite.
+UniStrView UniStrView_trim(UniStrView view);
+
+/// @brief Indique si deux vues désignent des chaînes égales.
+/// @param view1 la première vue.
+/// @param view2 la seconde vue.
+/// @return true si les chaînes sont égales, false sinon.
+bool UniStrView_equals(UniStrView view1, UniStrView view2);
+
+/// @brief Compare deux vues sans tenir compte de la casse des lettres ASCII.
+/// Les autres caractères sont comparés octet par octet.
+/// @param view1 la première vue.
+/// @param view2 la seconde vue.
+/// @return Un entier négatif, nul ou positif selon que la première chaîne
+/// est avant, égale ou après la seconde.
+int UniStrView_compareAsciiFold(UniStrView view1, UniStrView view2);
+
+/// @brief Indique si deux vues sont égales sans tenir compte de la casse des
+/// lettres ASCII.
+/// @param view1 la première vue.
+/// @param view2 la seconde vue.
+/// @return true si les chaînes sont égales, false sinon.
+bool UniStrView_equalsAsciiFold(UniStrView view1, UniStrView view2);
+
+/// @brief Indique si une vue commence par une autre.
+/// @param view la vue.
+/// @param prefix le préfixe.
+/// @return true si la vue commence par le préfixe, false sinon.
+bool UniStrView_startsWith(UniStrView view, UniStrView prefix);
+
+/// @brief Renvoie la position de la première occurrence d'une sous-chaîne.
+/// Cette méthode s'exécute en O(n + m) (algorithme Two-Way).
+/// @param view la vue.
+/// @param sub la sous-chaîne (non vide).
+/// @return La position en octets, ou -1 si la sous-chaîne est absente.
+int UniStrView_find(UniStrView view, UniStrView sub);
+
+/// @brief Renvoie la position de la dernière occurrence d'une sous-chaîne.
+/// Cette méthode s'exécute en O(n + m) (algorithme Two-Way).
+/// @param view la vue.
+/// @param sub la sous-chaîne (non vide).
+/// @return La position en octets, ou -1 si la sous-chaîne est absente.
+int UniStrView_rfind(UniStrView view, UniStrView sub);
+
+/// @brief Renvoie le nombre d'occurrences d'une sous-chaîne, qui peuvent se
+/// chevaucher (comme avec UniStr_count()).
+/// Cette méthode s'exécute en O(n + m) (algorithme Two-Way).
+/// @param view la vue.
+/// @param sub la sous-chaîne (non vide).
+/// @return Le nombre d'occurrences.
+int UniStrView_count(UniStrView view, UniStrView sub);
+
+/// @brief Extrait la partie suivante d'une chaîne découpée selon un
+/// séparateur.
+/// Une chaîne contenant n séparateurs donne n + 1 parties, éventuellement
+/// vides. Exemple de parcours :
+///     UniStrView rest = view, part;
+///     while (UniStrView_splitNext(&rest, sep, &part)) { ... }
+/// @param[in,out] rest la partie restant à découper. Elle est avancée après
+/// le séparateur ; son champ data vaut NULL une fois la dernière partie
+/// extraite.
+/// @param sep le séparateur (non vide).
+/// @param[out] part la partie extraite.
+/// @return true si une partie a été extraite, false si la chaîne est
+/// entièrement découpée.
+bool UniStrView_splitNext(UniStrView *rest, UniStrView sep, UniStrView *part);
+
+/// @brief Lit un entier à une position d'une vue.
+/// @param view la vue.
+/// @param start la position du premier octet à lire.
+/// @param[out] end adresse où écrire la position qui suit le nombre (start si
+/// aucun nombre n'est lu). Peut valoir NULL.
+/// @return La valeur lue, 0 si la vue ne contient pas de nombre à cette
+/// position.
+long long UniStrView_getInt(UniStrView view, int start, int *end);
+
+/// @brief Lit un nombre décimal à une position d'une vue (voir
+/// Number_parseDouble()).
+/// @param view la vue.
+/// @param start la position du premier octet à lire.
+/// @param[out] end adresse où écrire la position qui suit le nombre (start si
+/// aucun nombre n'est lu). Peut valoir NULL.
+/// @return La valeur lue, 0.0 si la vue ne contient pas de nombre à cette
+/// position.
+double UniStrView_getDouble(UniStrView view, int start, int *end);
+
+/// @brief Copie une vue dans un buffer et la termine par '\0'.
+/// Le contenu est tronqué si le buffer est trop petit.
+/// @param view la vue.
+/// @param buffer le buffer de destination.
+/// @param bufferSize la taille du buffer (terminateur '\0' compris).
+/// @return Le nombre d'octets écrits, sans le terminateur.
+int UniStrView_copyTo(UniStrView view, char *buffer, int bufferSize);